@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+// Number and bytes of allocations.
+struct AllocationStats {
+    std::size_t count = 0;
+    std::size_t bytes = 0;
+
+    AllocationStats operator-(const AllocationStats& rhs) const { return AllocationStats{count - rhs.count, bytes - rhs.bytes}; }
+    bool operator==(const AllocationStats& rhs) const = default;
+};
+
+// Counts the allocations of the current thread while it is alive, for example to check that iterating over a Grid
+// does not allocate. Allocations are recorded by CountingAllocator and, in programs that define
+// ALLOCATION_COUNTER_IMPLEMENT_OPERATOR_NEW before including this header in exactly one source file, by a
+// replacement of the global operator new.
+class AllocationCounter {
+public:
+    AllocationCounter() : start_{thread_stats()} { }
+
+    // allocations since the construction of the counter
+    [[nodiscard]] AllocationStats allocations() const { return thread_stats() - start_; }
+
+    // true if the global operator new is replaced, otherwise only CountingAllocator is counted
+    [[nodiscard]] static bool operator_new_hooked() { return operator_new_hooked_; }
+
+    static void record(const std::size_t bytes)
+    {
+        ++thread_stats().count;
+        thread_stats().bytes += bytes;
+    }
+
+private:
+    AllocationStats start_;
+
+    // trivially constructible, so operator new can use it at any time
+    static AllocationStats& thread_stats()
+    {
+        static thread_local AllocationStats stats;
+        return stats;
+    }
+
+    static inline bool operator_new_hooked_ = false;
+
+    friend struct AllocationCounterHook;
+};
+
+// allocations made by op() on the current thread
+template <typename Op>
+[[nodiscard]] AllocationStats count_allocations(Op&& op)
+{
+    const AllocationCounter counter;
+    op();
+    return counter.allocations();
+}
+
+// Allocator adaptor that counts the allocations of a single container, without replacing operator new.
+template <typename T, typename Allocator = std::allocator<T>>
+class CountingAllocator : public Allocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = CountingAllocator<U, typename std::allocator_traits<Allocator>::template rebind_alloc<U>>;
+    };
+
+    CountingAllocator() = default;
+    explicit CountingAllocator(const Allocator& alloc) : Allocator{alloc} { }
+
+    template <typename U, typename OtherAllocator>
+    CountingAllocator(const CountingAllocator<U, OtherAllocator>& other) : Allocator{static_cast<const OtherAllocator&>(other)} { }
+
+    [[nodiscard]] T* allocate(const std::size_t n)
+    {
+        AllocationCounter::record(n * sizeof(T));
+        return std::allocator_traits<Allocator>::allocate(*this, n);
+    }
+
+    void deallocate(T* p, const std::size_t n) { std::allocator_traits<Allocator>::deallocate(*this, p, n); }
+
+    template <typename U, typename OtherAllocator>
+    bool operator==(const CountingAllocator<U, OtherAllocator>& rhs) const { return static_cast<const Allocator&>(*this) == static_cast<const OtherAllocator&>(rhs); }
+};
+
+#if defined(ALLOCATION_COUNTER_IMPLEMENT_OPERATOR_NEW)
+
+// Replacement of the global operator new, its static instance sets operator_new_hooked() before main.
+struct AllocationCounterHook {
+    AllocationCounterHook() { AllocationCounter::operator_new_hooked_ = true; }
+
+    static void* allocate(std::size_t size, const std::size_t alignment)
+    {
+        AllocationCounter::record(size);
+
+        if (size == 0)
+            size = 1;
+
+        if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return std::malloc(size);
+
+        // aligned_alloc needs a multiple of the alignment
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    }
+
+    static void* allocate_or_throw(const std::size_t size, const std::size_t alignment)
+    {
+        void* p = allocate(size, alignment);
+
+        if (!p)
+            throw std::bad_alloc{};
+
+        return p;
+    }
+};
+
+static const AllocationCounterHook allocation_counter_hook;
+
+void* operator new(const std::size_t size) { return AllocationCounterHook::allocate_or_throw(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](const std::size_t size) { return AllocationCounterHook::allocate_or_throw(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(const std::size_t size, const std::align_val_t alignment) { return AllocationCounterHook::allocate_or_throw(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](const std::size_t size, const std::align_val_t alignment) { return AllocationCounterHook::allocate_or_throw(size, static_cast<std::size_t>(alignment)); }
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept { return AllocationCounterHook::allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept { return AllocationCounterHook::allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocationCounterHook::allocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocationCounterHook::allocate(size, static_cast<std::size_t>(alignment)); }
+
+// malloc and aligned_alloc are both released with free, GCC does not know that operator new uses them
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+// Versions of std::for_each, copy, fill, accumulate, transform and find that know how the values of an iterator
+// range lie in memory. Instead of going through operator++ and operator* for every value, they split the range
+// into chunks of values at ptr, ptr + stride, ... and loop over raw pointers, with a separate stride 1 loop the
+// compiler can vectorize:
+//
+//   - contiguous iterators (std::contiguous_iterator, for example CustomVector and std::vector): one chunk
+//   - segmented iterators (base() and segment_remaining(), SegmentedIterator): one chunk per segment
+//   - strided iterators (base() and stride(), StridedIterator for the rows and columns of a Grid): one chunk
+//
+// Other iterators use the std algorithm. In builds with GRID_ACCESS_TRACING all iterators do, so that every access
+// still goes through operator* and is recorded.
+
+// count values at ptr, ptr + stride, ..., ptr + (count - 1) * stride
+template <typename Pointer>
+struct MemoryChunk {
+    Pointer ptr;
+    std::ptrdiff_t stride;
+    std::ptrdiff_t count;
+};
+
+template <typename It>
+concept SegmentedMemoryIterator = std::random_access_iterator<It> && requires(const It it) {
+    { it.base() } -> std::same_as<std::add_pointer_t<std::iter_reference_t<It>>>;
+    { it.segment_remaining() } -> std::convertible_to<std::ptrdiff_t>;
+};
+
+template <typename It>
+concept StridedMemoryIterator = std::random_access_iterator<It> && requires(const It it) {
+    { it.base() } -> std::same_as<std::add_pointer_t<std::iter_reference_t<It>>>;
+    { it.stride() } -> std::convertible_to<std::ptrdiff_t>;
+};
+
+#if defined(GRID_ACCESS_TRACING)
+template <typename It>
+concept ChunkedMemoryIterator = false;
+#else
+template <typename It>
+concept ChunkedMemoryIterator = std::contiguous_iterator<It> || SegmentedMemoryIterator<It> || StridedMemoryIterator<It>;
+#endif
+
+// the chunk starting at it, with at most max_count values, it has to be dereferenceable
+template <ChunkedMemoryIterator It>
+[[nodiscard]] auto memory_chunk(const It& it, std::ptrdiff_t max_count);
+
+template <typename It, typename F>
+F segmented_for_each(It first, It last, F f);
+
+template <typename InputIt, typename OutputIt>
+OutputIt segmented_copy(InputIt first, InputIt last, OutputIt out);
+
+template <typename It, typename T>
+void segmented_fill(It first, It last, const T& value);
+
+template <typename It, typename T, typename BinaryOp = std::plus<>>
+[[nodiscard]] T segmented_accumulate(It first, It last, T init, BinaryOp op = {});
+
+template <typename InputIt, typename OutputIt, typename UnaryOp>
+OutputIt segmented_transform(InputIt first, InputIt last, OutputIt out, UnaryOp op);
+
+template <typename It, typename T>
+[[nodiscard]] It segmented_find(It first, It last, const T& value);
+
+template <ChunkedMemoryIterator It>
+auto memory_chunk(const It& it, const std::ptrdiff_t max_count)
+{
+    assert(max_count > 0);
+
+    if constexpr (std::contiguous_iterator<It>)
+        return MemoryChunk{std::to_address(it), 1, max_count};
+    else if constexpr (SegmentedMemoryIterator<It>)
+        return MemoryChunk{it.base(), 1, std::min<std::ptrdiff_t>(it.segment_remaining(), max_count)};
+    else
+        return MemoryChunk{it.base(), static_cast<std::ptrdiff_t>(it.stride()), max_count};
+}
+
+// calls f(value) for the values of the chunk
+template <typename Pointer, typename F>
+void for_each_in_chunk(const MemoryChunk<Pointer>& chunk, F& f)
+{
+    if (chunk.stride == 1) {
+        for (std::ptrdiff_t i = 0; i < chunk.count; ++i)
+            f(chunk.ptr[i]);
+    } else {
+        for (std::ptrdiff_t i = 0; i < chunk.count; ++i)
+            f(chunk.ptr[i * chunk.stride]);
+    }
+}
+
+// calls f(in value, out value) for the first count values of both chunks
+template <typename InputPointer, typename OutputPointer, typename F>
+void for_each_in_chunks(const MemoryChunk<InputPointer>& in, const MemoryChunk<OutputPointer>& out, const std::ptrdiff_t count, F& f)
+{
+    if (in.stride == 1 && out.stride == 1) {
+        for (std::ptrdiff_t i = 0; i < count; ++i)
+            f(in.ptr[i], out.ptr[i]);
+    } else {
+        for (std::ptrdiff_t i = 0; i < count; ++i)
+            f(in.ptr[i * in.stride], out.ptr[i * out.stride]);
+    }
+}
+
+// calls f(in value, out value) for all values of [first, last) and the values starting at out
+template <typename InputIt, typename OutputIt, typename F>
+OutputIt for_each_pair(InputIt first, const InputIt last, OutputIt out, F f)
+{
+    while (first != last) {
+        const auto in_chunk = memory_chunk(first, last - first);
+
+        if constexpr (ChunkedMemoryIterator<OutputIt>) {
+            // the output chunk can be shorter, for example at the end of a segment
+            const auto out_chunk = memory_chunk(out, in_chunk.count);
+            for_each_in_chunks(in_chunk, out_chunk, out_chunk.count, f);
+            first += out_chunk.count;
+            out += out_chunk.count;
+        } else {
+            auto write = [&](auto& value) {
+                f(value, *out);
+                ++out;
+            };
+
+            for_each_in_chunk(in_chunk, write);
+            first += in_chunk.count;
+        }
+    }
+
+    return out;
+}
+
+template <typename It, typename F>
+F segmented_for_each(It first, const It last, F f)
+{
+    if constexpr (ChunkedMemoryIterator<It>) {
+        while (first != last) {
+            const auto chunk = memory_chunk(first, last - first);
+            for_each_in_chunk(chunk, f);
+            first += chunk.count;
+        }
+
+        return f;
+    } else {
+        return std::for_each(first, last, std::move(f));
+    }
+}
+
+template <typename InputIt, typename OutputIt>
+OutputIt segmented_copy(const InputIt first, const InputIt last, const OutputIt out)
+{
+    if constexpr (ChunkedMemoryIterator<InputIt>)
+        return for_each_pair(first, last, out, [](const auto& in, auto&& dest) { dest = in; });
+    else
+        return std::copy(first, last, out);
+}
+
+template <typename It, typename T>
+void segmented_fill(const It first, const It last, const T& value)
+{
+    if constexpr (ChunkedMemoryIterator<It>)
+        segmented_for_each(first, last, [&](auto& dest) { dest = value; });
+    else
+        std::fill(first, last, value);
+}
+
+template <typename It, typename T, typename BinaryOp>
+T segmented_accumulate(const It first, const It last, T init, BinaryOp op)
+{
+    if constexpr (ChunkedMemoryIterator<It>) {
+        // a loop of its own instead of segmented_for_each(), so init can stay in a register
+        for (It it = first; it != last;) {
+            const auto chunk = memory_chunk(it, last - it);
+
+            if (chunk.stride == 1) {
+                for (std::ptrdiff_t i = 0; i < chunk.count; ++i)
+                    init = op(std::move(init), chunk.ptr[i]);
+            } else {
+                for (std::ptrdiff_t i = 0; i < chunk.count; ++i)
+                    init = op(std::move(init), chunk.ptr[i * chunk.stride]);
+            }
+
+            it += chunk.count;
+        }
+
+        return init;
+    } else {
+        return std::accumulate(first, last, std::move(init), std::move(op));
+    }
+}
+
+template <typename InputIt, typename OutputIt, typename UnaryOp>
+OutputIt segmented_transform(const InputIt first, const InputIt last, const OutputIt out, UnaryOp op)
+{
+    if constexpr (ChunkedMemoryIterator<InputIt>)
+        return for_each_pair(first, last, out, [&](const auto& in, auto&& dest) { dest = op(in); });
+    else
+        return std::transform(first, last, out, std::move(op));
+}
+
+template <typename It, typename T>
+It segmented_find(It first, const It last, const T& value)
+{
+    if constexpr (ChunkedMemoryIterator<It>) {
+        while (first != last) {
+            const auto chunk = memory_chunk(first, last - first);
+
+            for (std::ptrdiff_t i = 0; i < chunk.count; ++i)
+                if (chunk.ptr[i * chunk.stride] == value)
+                    return first + i;
+
+            first += chunk.count;
+        }
+
+        return last;
+    } else {
+        return std::find(first, last, value);
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+enum class AccessKind : std::uint8_t {
+    read,
+    write
+};
+
+struct Access {
+    std::uintptr_t address;
+    std::uint32_t thread;
+    AccessKind kind;
+};
+
+// Lock-free ring buffer of memory accesses, keeping the last capacity() ones. Any number of threads can record at
+// the same time, each access takes one fetch_add and three relaxed stores. snapshot() is meant to be called while no
+// thread is recording, for example after the traced algorithm has finished or its threads have been joined.
+//
+// In builds with GRID_ACCESS_TRACING defined, Grid::at(), the row and column iterators, GridCursor::value() and
+// Neighborhood values record every access in AccessTrace::global(). Accesses through non-const references count
+// as writes. access_trace_report.hpp turns the accesses into heatmaps and reuse distance histograms.
+class AccessTrace {
+public:
+    explicit AccessTrace(std::size_t capacity);
+
+    AccessTrace(const AccessTrace&) = delete;
+    AccessTrace& operator=(const AccessTrace&) = delete;
+
+    [[nodiscard]] std::size_t capacity() const { return capacity_; }
+
+    // number of accesses since the last clear(), including the ones that were overwritten
+    [[nodiscard]] std::uint64_t recorded() const { return head_.load(std::memory_order_acquire); }
+
+    void record(const void* address, AccessKind kind);
+    void clear() { head_.store(0, std::memory_order_release); }
+
+    // the recorded accesses that are still in the buffer, oldest first
+    [[nodiscard]] std::vector<Access> snapshot() const;
+
+    // small id of the calling thread, in the order the threads first recorded an access
+    [[nodiscard]] static std::uint32_t thread_id();
+
+    [[nodiscard]] static AccessTrace& global();
+
+private:
+    struct Slot {
+        std::atomic<std::uintptr_t> address;
+        std::atomic<std::uint32_t> thread;
+        std::atomic<AccessKind> kind;
+    };
+
+    std::size_t capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<std::uint64_t> head_ = 0;
+};
+
+// records an access to *ptr in AccessTrace::global(), a write unless ptr points to const
+template <typename T>
+void trace_access(T* ptr)
+{
+    AccessTrace::global().record(ptr, std::is_const_v<T> ? AccessKind::read : AccessKind::write);
+}
+
+inline AccessTrace::AccessTrace(const std::size_t capacity) : capacity_{capacity}, slots_{std::make_unique<Slot[]>(capacity)}
+{
+    assert(std::has_single_bit(capacity));
+}
+
+inline void AccessTrace::record(const void* address, const AccessKind kind)
+{
+    Slot& slot = slots_[head_.fetch_add(1, std::memory_order_relaxed) & (capacity_ - 1)];
+    slot.address.store(reinterpret_cast<std::uintptr_t>(address), std::memory_order_relaxed);
+    slot.thread.store(thread_id(), std::memory_order_relaxed);
+    slot.kind.store(kind, std::memory_order_relaxed);
+}
+
+inline std::vector<Access> AccessTrace::snapshot() const
+{
+    const std::uint64_t head = recorded();
+    const std::uint64_t first = head > capacity_ ? head - capacity_ : 0;
+
+    std::vector<Access> accesses;
+    accesses.reserve(head - first);
+
+    for (std::uint64_t i = first; i < head; ++i) {
+        const Slot& slot = slots_[i & (capacity_ - 1)];
+        accesses.push_back(Access{slot.address.load(std::memory_order_relaxed), slot.thread.load(std::memory_order_relaxed), slot.kind.load(std::memory_order_relaxed)});
+    }
+
+    return accesses;
+}
+
+inline std::uint32_t AccessTrace::thread_id()
+{
+    static std::atomic<std::uint32_t> next_id = 0;
+    thread_local const std::uint32_t id = next_id.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+// 4M accesses (64 MB)
+inline AccessTrace& AccessTrace::global()
+{
+    static AccessTrace trace{std::size_t{1} << 22};
+    return trace;
+}
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "fmt/core.h"
+
+#include "access_trace.hpp"
+#include "grid.hpp"
+
+// An access to the values of one grid.
+struct GridAccess {
+    std::size_t index;
+    std::uint32_t thread;
+    AccessKind kind;
+};
+
+// Memory layouts the accesses of a row-major grid can be replayed in, to see which one suits an algorithm.
+enum class TraceLayout {
+    row_major,
+    tiled,   // 8x8 tiles, the tiles and the values inside of a tile are row-major
+    morton   // Z-order curve, interleaved bits of column and row
+};
+
+// Reuse distance: the number of distinct cache lines accessed between two accesses to the same cache line.
+// An access hits in a fully associative LRU cache of n lines exactly if its reuse distance is less than n.
+struct ReuseDistanceHistogram {
+    std::size_t cold = 0;               // first accesses of a cache line
+    std::vector<std::size_t> buckets;  // buckets[0]: distance 0, buckets[i]: distances in [2^(i-1), 2^i)
+
+    [[nodiscard]] std::size_t total() const;
+
+    // fraction of the accesses that hit in a fully associative LRU cache, exact for powers of two
+    [[nodiscard]] double hit_rate(std::size_t cache_lines) const;
+};
+
+// the accesses to the values in [data, data + size), with their linear index
+template <typename T>
+[[nodiscard]] std::vector<GridAccess> grid_accesses(std::span<const Access> accesses, const T* data, std::size_t size);
+
+template <typename T, typename CoordsType, typename Allocator>
+[[nodiscard]] std::vector<GridAccess> grid_accesses(std::span<const Access> accesses, const Grid<T, CoordsType, Allocator>& grid)
+{
+    return grid_accesses(accesses, grid.data(), static_cast<std::size_t>(grid.size()));
+}
+
+// position of the value at the linear (row-major) index in the layout, in values
+[[nodiscard]] inline std::size_t layout_offset(TraceLayout layout, std::size_t index, int width);
+
+[[nodiscard]] inline ReuseDistanceHistogram reuse_distances(std::span<const GridAccess> accesses, int width, TraceLayout layout, std::size_t value_size, std::size_t line_size = 64);
+
+// Accesses over time (x) and linear index (y), the value of a pixel is the number of accesses it covers.
+// A row-major sweep is a diagonal line, a column sweep a set of parallel lines.
+[[nodiscard]] inline Grid<std::uint32_t> locality_heatmap(std::span<const GridAccess> accesses, std::size_t grid_size, int image_width, int image_height);
+
+// Writes a binary PGM image with logarithmic brightness, white for the pixel with the most accesses.
+inline void write_pgm(std::ostream& out, const Grid<std::uint32_t>& image);
+
+// the non-empty buckets and the hit rates of caches of typical sizes
+inline void write_reuse_distance_report(std::ostream& out, const ReuseDistanceHistogram& histogram, std::size_t line_size = 64);
+
+inline std::size_t ReuseDistanceHistogram::total() const
+{
+    std::size_t sum = cold;
+
+    for (const std::size_t count : buckets)
+        sum += count;
+
+    return sum;
+}
+
+inline double ReuseDistanceHistogram::hit_rate(const std::size_t cache_lines) const
+{
+    std::size_t hits = 0;
+
+    // bucket i holds distances below 2^i
+    for (std::size_t i = 0; i < buckets.size() && (std::size_t{1} << i) <= cache_lines; ++i)
+        hits += buckets[i];
+
+    const std::size_t accesses = total();
+    return accesses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(accesses);
+}
+
+template <typename T>
+std::vector<GridAccess> grid_accesses(const std::span<const Access> accesses, const T* data, const std::size_t size)
+{
+    const auto first = reinterpret_cast<std::uintptr_t>(data);
+    const auto last = reinterpret_cast<std::uintptr_t>(data + size);
+    std::vector<GridAccess> result;
+
+    for (const Access& access : accesses)
+        if (access.address >= first && access.address < last)
+            result.push_back(GridAccess{(access.address - first) / sizeof(T), access.thread, access.kind});
+
+    return result;
+}
+
+inline std::size_t layout_offset(const TraceLayout layout, const std::size_t index, const int width)
+{
+    assert(width > 0);
+    const auto cols = static_cast<std::size_t>(width);
+    const std::size_t col = index % cols;
+    const std::size_t row = index / cols;
+
+    switch (layout) {
+        case TraceLayout::row_major:
+            return index;
+        case TraceLayout::tiled: {
+            constexpr std::size_t tile_size = 8;
+            const std::size_t tiles_per_row = (cols + tile_size - 1) / tile_size;
+            const std::size_t tile = (row / tile_size) * tiles_per_row + col / tile_size;
+            return tile * tile_size * tile_size + (row % tile_size) * tile_size + col % tile_size;
+        }
+        case TraceLayout::morton: {
+            std::size_t offset = 0;
+
+            for (std::size_t bit = 0; (col >> bit) != 0 || (row >> bit) != 0; ++bit)
+                offset |= ((col >> bit) & 1) << (2 * bit) | ((row >> bit) & 1) << (2 * bit + 1);
+
+            return offset;
+        }
+    }
+
+    return index;
+}
+
+// O(n log n): a Fenwick tree over the time of the accesses marks the last access of every cache line,
+// the distance of an access is the number of marks since the previous access to its cache line.
+inline ReuseDistanceHistogram reuse_distances(const std::span<const GridAccess> accesses, const int width, const TraceLayout layout, const std::size_t value_size, const std::size_t line_size)
+{
+    assert(value_size > 0 && line_size > 0);
+
+    ReuseDistanceHistogram histogram;
+    std::vector<std::size_t> tree(accesses.size() + 1);
+    std::unordered_map<std::size_t, std::size_t> last_access;
+
+    const auto mark = [&](std::size_t pos, const bool set) {
+        for (++pos; pos < tree.size(); pos += pos & (~pos + 1))
+            tree[pos] = set ? tree[pos] + 1 : tree[pos] - 1;
+    };
+
+    // number of marks in [0, pos)
+    const auto prefix_sum = [&](std::size_t pos) {
+        std::size_t sum = 0;
+
+        for (; pos > 0; pos -= pos & (~pos + 1))
+            sum += tree[pos];
+
+        return sum;
+    };
+
+    for (std::size_t time = 0; time < accesses.size(); ++time) {
+        const std::size_t line = layout_offset(layout, accesses[time].index, width) * value_size / line_size;
+        const auto [it, first_access] = last_access.try_emplace(line, time);
+
+        if (first_access) {
+            ++histogram.cold;
+        } else {
+            const std::size_t distance = prefix_sum(time) - prefix_sum(it->second + 1);
+            const std::size_t bucket = std::bit_width(distance);
+
+            if (histogram.buckets.size() <= bucket)
+                histogram.buckets.resize(bucket + 1);
+
+            ++histogram.buckets[bucket];
+            mark(it->second, false);
+            it->second = time;
+        }
+
+        mark(time, true);
+    }
+
+    return histogram;
+}
+
+inline Grid<std::uint32_t> locality_heatmap(const std::span<const GridAccess> accesses, const std::size_t grid_size, const int image_width, const int image_height)
+{
+    assert(grid_size > 0);
+    Grid<std::uint32_t> image{image_width, image_height};
+
+    for (std::size_t time = 0; time < accesses.size(); ++time) {
+        const auto x = static_cast<int>(time * static_cast<std::size_t>(image_width) / accesses.size());
+        const auto y = static_cast<int>(std::min(accesses[time].index, grid_size - 1) * static_cast<std::size_t>(image_height) / grid_size);
+        ++image.at(x, y);
+    }
+
+    return image;
+}
+
+inline void write_pgm(std::ostream& out, const Grid<std::uint32_t>& image)
+{
+    const std::uint32_t max = *std::max_element(image.begin(), image.end());
+    const double scale = max == 0 ? 0.0 : 255.0 / std::log1p(static_cast<double>(max));
+
+    out << "P5\n" << image.width() << " " << image.height() << "\n255\n";
+
+    for (const std::uint32_t count : image)
+        out.put(static_cast<char>(static_cast<unsigned char>(std::lround(std::log1p(static_cast<double>(count)) * scale))));
+}
+
+inline void write_reuse_distance_report(std::ostream& out, const ReuseDistanceHistogram& histogram, const std::size_t line_size)
+{
+    const std::size_t total = histogram.total();
+    const auto percent = [&](const std::size_t count) { return total == 0 ? 0.0 : 100.0 * static_cast<double>(count) / static_cast<double>(total); };
+
+    out << fmt::format("  {:>21} {:>10} {:>7}\n", "reuse distance", "accesses", "");
+    out << fmt::format("  {:>21} {:>10} {:>6.2f}%\n", "cold", histogram.cold, percent(histogram.cold));
+
+    for (std::size_t i = 0; i < histogram.buckets.size(); ++i) {
+        if (histogram.buckets[i] == 0)
+            continue;
+
+        const std::size_t first = i == 0 ? 0 : std::size_t{1} << (i - 1);
+        const std::size_t last = i == 0 ? 0 : (std::size_t{1} << i) - 1;
+        out << fmt::format("  {:>10} .. {:>7} {:>10} {:>6.2f}%\n", first, last, histogram.buckets[i], percent(histogram.buckets[i]));
+    }
+
+    // typical cache sizes as fully associative LRU caches
+    for (const auto& [name, bytes] : {std::pair{"32 KB (L1)", 32u << 10}, std::pair{"1 MB (L2)", 1u << 20}, std::pair{"32 MB (L3)", 32u << 20}})
+        out << fmt::format("  hit rate {:>10}: {:6.2f}%\n", name, 100.0 * histogram.hit_rate(bytes / line_size));
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "grid.hpp"
+
+// Grid whose cells are only accessed through std::atomic_ref, so many threads can scatter into it without a lock.
+// Optionally the cells are grouped into tiles that each start on their own cache line, which keeps threads
+// that work on different tiles from invalidating each other's cache lines (false sharing).
+template <typename T = int, typename CoordsType = Coords<int>>
+class AtomicGrid {
+public:
+    using size_type = int;
+    using value_type = T;
+    using coords_type = CoordsType;
+    using atomic_reference = std::atomic_ref<T>;
+
+    static constexpr std::size_t cache_line_size = 64;
+
+    static_assert(alignof(T) >= std::atomic_ref<T>::required_alignment, "T is not sufficiently aligned for std::atomic_ref");
+    static_assert(sizeof(T) <= cache_line_size && cache_line_size % sizeof(T) == 0, "T must evenly divide a cache line");
+
+    AtomicGrid(size_type cols, size_type rows);
+    AtomicGrid(size_type cols, size_type rows, const T& value);
+    AtomicGrid(size_type cols, size_type rows, const T& value, size_type tile_cols, size_type tile_rows);
+
+    size_type width() const { return cols_; }
+    size_type height() const { return rows_; }
+
+    size_type size() const { return cols_ * rows_; }
+
+    size_type tile_width() const { return tile_cols_; }
+    size_type tile_height() const { return tile_rows_; }
+
+    [[nodiscard]] atomic_reference atomic(size_type col, size_type row) { return atomic_reference{data_[idx(col, row)]}; }
+    [[nodiscard]] atomic_reference atomic(const coords_type& coords) { return atomic(coords.col(), coords.row()); }
+
+    [[nodiscard]] T load(const coords_type& coords, std::memory_order order = std::memory_order_seq_cst) const;
+    void store(const coords_type& coords, const T& value, std::memory_order order = std::memory_order_seq_cst) { atomic(coords).store(value, order); }
+
+    T fetch_add(const coords_type& coords, const T& arg, std::memory_order order = std::memory_order_seq_cst) { return atomic(coords).fetch_add(arg, order); }
+    T fetch_sub(const coords_type& coords, const T& arg, std::memory_order order = std::memory_order_seq_cst) { return atomic(coords).fetch_sub(arg, order); }
+    T fetch_min(const coords_type& coords, const T& arg, std::memory_order order = std::memory_order_seq_cst);
+    T fetch_max(const coords_type& coords, const T& arg, std::memory_order order = std::memory_order_seq_cst);
+
+    bool compare_exchange(const coords_type& coords, T& expected, const T& desired, std::memory_order order = std::memory_order_seq_cst) { return atomic(coords).compare_exchange_strong(expected, desired, order); }
+
+    [[nodiscard]] Grid<T, coords_type> to_grid() const;
+
+private:
+    size_type cols_;
+    size_type rows_;
+    size_type tile_cols_;
+    size_type tile_rows_;
+    size_type tiles_per_row_;
+    size_type tile_stride_;
+
+    std::vector<T, AlignedAllocator<T, cache_line_size>> data_;
+
+    [[nodiscard]] inline std::size_t idx(size_type col, size_type row) const;
+};
+
+template <typename T, typename CoordsType>
+AtomicGrid<T, CoordsType>::AtomicGrid(const size_type cols, const size_type rows) : AtomicGrid(cols, rows, T{}) { }
+
+template <typename T, typename CoordsType>
+AtomicGrid<T, CoordsType>::AtomicGrid(const size_type cols, const size_type rows, const T& value) : AtomicGrid(cols, rows, value, cols, rows) { }
+
+template <typename T, typename CoordsType>
+AtomicGrid<T, CoordsType>::AtomicGrid(const size_type cols, const size_type rows, const T& value, const size_type tile_cols, const size_type tile_rows)
+{
+    assert(cols > 0 && rows > 0);
+    assert(cols - 1 <= coords_type::max());
+    assert(rows - 1 <= coords_type::max());
+    assert(tile_cols > 0 && tile_cols <= cols);
+    assert(tile_rows > 0 && tile_rows <= rows);
+
+    constexpr auto cells_per_cache_line = static_cast<size_type>(cache_line_size / sizeof(T));
+
+    cols_ = cols;
+    rows_ = rows;
+    tile_cols_ = tile_cols;
+    tile_rows_ = tile_rows;
+    tiles_per_row_ = (cols + tile_cols - 1) / tile_cols;
+    tile_stride_ = (tile_cols * tile_rows + cells_per_cache_line - 1) / cells_per_cache_line * cells_per_cache_line;
+
+    const size_type tiles_per_col = (rows + tile_rows - 1) / tile_rows;
+    data_ = std::vector<T, AlignedAllocator<T, cache_line_size>>(static_cast<std::size_t>(tiles_per_row_ * tiles_per_col * tile_stride_), value);
+}
+
+template <typename T, typename CoordsType>
+T AtomicGrid<T, CoordsType>::load(const coords_type& coords, const std::memory_order order) const
+{
+    // std::atomic_ref<const T> is not available before C++26, the value is only read
+    return atomic_reference{const_cast<T&>(data_[idx(coords.col(), coords.row())])}.load(order);
+}
+
+template <typename T, typename CoordsType>
+T AtomicGrid<T, CoordsType>::fetch_min(const coords_type& coords, const T& arg, const std::memory_order order)
+{
+    auto ref = atomic(coords);
+    T current = ref.load(std::memory_order_relaxed);
+
+    while (arg < current && !ref.compare_exchange_weak(current, arg, order, std::memory_order_relaxed)) { }
+
+    return current;
+}
+
+template <typename T, typename CoordsType>
+T AtomicGrid<T, CoordsType>::fetch_max(const coords_type& coords, const T& arg, const std::memory_order order)
+{
+    auto ref = atomic(coords);
+    T current = ref.load(std::memory_order_relaxed);
+
+    while (current < arg && !ref.compare_exchange_weak(current, arg, order, std::memory_order_relaxed)) { }
+
+    return current;
+}
+
+template <typename T, typename CoordsType>
+Grid<T, CoordsType> AtomicGrid<T, CoordsType>::to_grid() const
+{
+    Grid<T, coords_type> grid{cols_, rows_};
+
+    for (size_type row = 0; row < rows_; ++row)
+        for (size_type col = 0; col < cols_; ++col)
+            grid.at(col, row) = load(coords_type{static_cast<typename coords_type::coordinates_type>(col), static_cast<typename coords_type::coordinates_type>(row)}, std::memory_order_relaxed);
+
+    return grid;
+}
+
+template <typename T, typename CoordsType>
+std::size_t AtomicGrid<T, CoordsType>::idx(const size_type col, const size_type row) const
+{
+    assert(col >= 0 && col < cols_);
+    assert(row >= 0 && row < rows_);
+
+    if (tile_cols_ == cols_ && tile_rows_ == rows_)
+        return static_cast<std::size_t>(row * cols_ + col);
+
+    const size_type tile = (row / tile_rows_) * tiles_per_row_ + col / tile_cols_;
+    return static_cast<std::size_t>(tile * tile_stride_ + (row % tile_rows_) * tile_cols_ + col % tile_cols_);
+}
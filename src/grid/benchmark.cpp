@@ -1,42 +1,140 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #define ANKERL_NANOBENCH_IMPLEMENT
 #include "nanobench.h"
 
+// --allocations needs the replaced operator new, which the build option GRID_BENCHMARK_COUNT_ALLOCATIONS enables
+#include "allocation_counter.hpp"
+
 #include "fmt/core.h"
 
+#include "benchmark_suite.hpp"
+#include "bricked_volume.hpp"
+#include "coords_batch.hpp"
+#include "coords_map.hpp"
 #include "grid.hpp"
+#include "huge_page_allocator.hpp"
+#include "nd_grid.hpp"
+#include "packed_coords.hpp"
+#include "resizable_grid.hpp"
+#include "segmented_algorithms.hpp"
+#include "torus_view.hpp"
+
+// type to sum up values of type T without overflowing small integer types
+template <typename T>
+using accumulator_t = decltype(T{} + T{});
+
+template <typename T, typename CoordsType>
+std::string grid_name()
+{
+    return fmt::format("Grid<{}, {}>", TypeName<T>::name(), TypeName<CoordsType>::name());
+}
 
-Grid<int, Coords<short>> create_grid_with_numbered_values(const int rows, const int cols)
+template <typename T, typename CoordsType>
+Grid<T, CoordsType> create_grid_with_numbered_values(const int rows, const int cols)
 {
-    Grid<int, Coords<short>> grid{rows, cols};
+    Grid<T, CoordsType> grid{rows, cols};
 
     for (int row = 0; row < rows; ++row)
         for (int col = 0; col < cols; ++col)
-            grid[row][col] = (row + 1) * 10 + col + 1;
+            grid[row][col] = static_cast<T>((row + 1) * 10 + col + 1);
 
     return grid;
 }
 
-void benchmark_create_grid()
+template <typename CoordsType = Coords<int>>
+std::vector<CoordsType> random_coords(const int cols, const int rows, const std::size_t count)
 {
-    for (auto size : {4, 16, 256, 1024}) {
-        ankerl::nanobench::Bench().run(fmt::format("create grid: {}x{}", size, size), [&] {
-            const auto grid = create_grid_with_numbered_values(size, size);
+    using coordinates_type = typename CoordsType::coordinates_type;
+
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<int> x{0, cols - 1};
+    std::uniform_int_distribution<int> y{0, rows - 1};
+    std::vector<CoordsType> coords(count);
+
+    for (auto& c : coords)
+        c = CoordsType{static_cast<coordinates_type>(x(gen)), static_cast<coordinates_type>(y(gen))};
+
+    return coords;
+}
+
+template <typename T, typename CoordsType>
+void benchmark_create_grid(BenchmarkSuite& suite)
+{
+    for (const auto size : suite.sizes()) {
+        suite.run(fmt::format("create {}: {}x{}", grid_name<T, CoordsType>(), size, size), [&] {
+            const auto grid = create_grid_with_numbered_values<T, CoordsType>(size, size);
             ankerl::nanobench::doNotOptimizeAway(grid);
         });
     }
 }
 
-void benchmark_sum_baseline()
+// Many short-lived small grids: from the default heap versus bump allocated from a monotonic arena that is released per "frame".
+template <typename T, typename CoordsType>
+void benchmark_create_grid_pmr(BenchmarkSuite& suite)
+{
+    constexpr int grids_per_frame = 100;
+
+    for (const auto size : suite.sizes()) {
+        if (size > 16)
+            continue;
+
+        suite.run(fmt::format("create {} (heap): {}x{}", grid_name<T, CoordsType>(), size, size), {.batch = grids_per_frame}, [&] {
+            for (int i = 0; i < grids_per_frame; ++i) {
+                const Grid<T, CoordsType> grid{size, size, static_cast<T>(i)};
+                ankerl::nanobench::doNotOptimizeAway(grid);
+            }
+        });
+
+        const auto pmr_name = fmt::format("create {} (monotonic pmr): {}x{}", grid_name<T, CoordsType>(), size, size);
+
+        if (!suite.enabled(pmr_name))
+            continue;
+
+        std::vector<std::byte> buffer(static_cast<std::size_t>(grids_per_frame * size * size) * sizeof(T) * 2);
+
+        suite.run(pmr_name, {.batch = grids_per_frame}, [&] {
+            std::pmr::monotonic_buffer_resource resource{buffer.data(), buffer.size()};
+
+            for (int i = 0; i < grids_per_frame; ++i) {
+                const PmrGrid<T, CoordsType> grid{size, size, static_cast<T>(i), &resource};
+                ankerl::nanobench::doNotOptimizeAway(grid);
+            }
+        });
+    }
+}
+
+template <typename T, typename CoordsType>
+void benchmark_sum_baseline(BenchmarkSuite& suite)
 {
-    for (auto size : {4, 16, 256, 1024}) {
-        std::vector<int> vec(static_cast<std::size_t>(size * size));
+    for (const auto size : suite.sizes()) {
+        const auto name = fmt::format("sum baseline std::vector<{}>: {}x{}", TypeName<T>::name(), size, size);
+
+        if (!suite.enabled(name))
+            continue;
+
+        std::vector<T> vec(static_cast<std::size_t>(size) * static_cast<std::size_t>(size));
 
         for (int row = 0; row < size; ++row)
             for (int col = 0; col < size; ++col)
-                vec[static_cast<std::size_t>(row * size + col)] = (row + 1) * 10 + col + 1;
+                vec[static_cast<std::size_t>(row) * static_cast<std::size_t>(size) + static_cast<std::size_t>(col)] = static_cast<T>((row + 1) * 10 + col + 1);
 
-        ankerl::nanobench::Bench().run(fmt::format("sum baseline: {}x{}", size, size), [&] {
-            int sum = 0;
+        suite.run(name, [&] {
+            accumulator_t<T> sum{};
 
             for (const auto i : vec)
                 sum += i;
@@ -46,107 +144,599 @@ void benchmark_sum_baseline()
     }
 }
 
-void benchmark_sum_vector()
+// Runs op(grid) as benchmark "<what> <grid type>: <size>x<size>" for all sizes, creating the grids only for selected benchmarks.
+// Times and counters are reported per cell, so they can be compared across sizes.
+template <typename T, typename CoordsType, typename Op>
+void benchmark_grid(BenchmarkSuite& suite, const char* what, Op op)
 {
-    for (auto size : {4, 16, 256, 1024}) {
-        const auto grid = create_grid_with_numbered_values(size, size);
+    for (const auto size : suite.sizes()) {
+        const auto name = fmt::format("{} {}: {}x{}", what, grid_name<T, CoordsType>(), size, size);
 
-        ankerl::nanobench::Bench().run(fmt::format("sum vector: {}x{}", size, size), [&] {
-            int sum = 0;
+        if (!suite.enabled(name))
+            continue;
+
+        const auto grid = create_grid_with_numbered_values<T, CoordsType>(size, size);
+        suite.run(name, {.batch = static_cast<std::size_t>(grid.size()), .unit = "cell"}, [&] { ankerl::nanobench::doNotOptimizeAway(op(grid)); });
+    }
+}
 
-            for (const auto i : grid)
+template <typename T, typename CoordsType>
+void benchmark_sum_vector(BenchmarkSuite& suite)
+{
+    benchmark_grid<T, CoordsType>(suite, "sum vector", [](const auto& grid) {
+        accumulator_t<T> sum{};
+
+        for (const auto i : grid)
+            sum += i;
+
+        return sum;
+    });
+}
+
+template <typename T, typename CoordsType>
+void benchmark_sum_rows(BenchmarkSuite& suite)
+{
+    benchmark_grid<T, CoordsType>(suite, "sum rows", [](const auto& grid) {
+        accumulator_t<T> sum{};
+
+        for (auto& row : grid.rows())
+            for (auto i : row)
                 sum += i;
 
-            ankerl::nanobench::doNotOptimizeAway(sum);
+        return sum;
+    });
+}
+
+template <typename T, typename CoordsType>
+void benchmark_sum_cols(BenchmarkSuite& suite)
+{
+    benchmark_grid<T, CoordsType>(suite, "sum columns", [](const auto& grid) {
+        accumulator_t<T> sum{};
+
+        for (auto& col : grid.cols())
+            for (auto i : col)
+                sum += i;
+
+        return sum;
+    });
+}
+
+template <typename T, typename CoordsType>
+void benchmark_sum_rows_segmented(BenchmarkSuite& suite)
+{
+    benchmark_grid<T, CoordsType>(suite, "sum rows segmented_accumulate()", [](const auto& grid) {
+        accumulator_t<T> sum{};
+
+        for (auto& row : grid.rows())
+            sum = segmented_accumulate(row.begin(), row.end(), sum);
+
+        return sum;
+    });
+}
+
+template <typename T, typename CoordsType>
+void benchmark_sum_cols_segmented(BenchmarkSuite& suite)
+{
+    benchmark_grid<T, CoordsType>(suite, "sum columns segmented_accumulate()", [](const auto& grid) {
+        accumulator_t<T> sum{};
+
+        for (auto& col : grid.cols())
+            sum = segmented_accumulate(col.begin(), col.end(), sum);
+
+        return sum;
+    });
+}
+
+template <typename T, typename CoordsType>
+void benchmark_sum_cell_rows(BenchmarkSuite& suite)
+{
+    benchmark_grid<T, CoordsType>(suite, "sum cell rows", [](const auto& grid) {
+        accumulator_t<T> sum{};
+
+        for (int row = 0; row < grid.height(); ++row) {
+            auto cell = grid.cell(0, row);
+
+            while (cell.col() < grid.width()) {
+                sum += cell.value();
+                cell.move_right();
+            }
+        }
+
+        return sum;
+    });
+}
+
+template <typename T, typename CoordsType>
+void benchmark_sum_cell_cols(BenchmarkSuite& suite)
+{
+    benchmark_grid<T, CoordsType>(suite, "sum cell cols", [](const auto& grid) {
+        accumulator_t<T> sum{};
+
+        for (int col = 0; col < grid.width(); ++col) {
+            auto cell = grid.cell(col, 0);
+
+            while (cell.row() < grid.height()) {
+                sum += cell.value();
+                cell.move_down();
+            }
+        }
+
+        return sum;
+    });
+}
+
+template <typename T, typename CoordsType>
+void benchmark_sum_cursor_rows(BenchmarkSuite& suite)
+{
+    benchmark_grid<T, CoordsType>(suite, "sum cursor rows", [](const auto& grid) {
+        accumulator_t<T> sum{};
+
+        for (int row = 0; row < grid.height(); ++row) {
+            auto cursor = grid.cursor(0, row);
+
+            while (cursor.col() < grid.width()) {
+                sum += cursor.value();
+                cursor.move_right();
+            }
+        }
+
+        return sum;
+    });
+}
+
+template <typename T, typename CoordsType>
+void benchmark_sum_cursor_cols(BenchmarkSuite& suite)
+{
+    benchmark_grid<T, CoordsType>(suite, "sum cursor cols", [](const auto& grid) {
+        accumulator_t<T> sum{};
+
+        for (int col = 0; col < grid.width(); ++col) {
+            auto cursor = grid.cursor(col, 0);
+
+            while (cursor.row() < grid.height()) {
+                sum += cursor.value();
+                cursor.move_down();
+            }
+        }
+
+        return sum;
+    });
+}
+
+template <typename T, typename CoordsType>
+void benchmark_sum_neighbors_at(BenchmarkSuite& suite)
+{
+    benchmark_grid<T, CoordsType>(suite, "sum neighbors at()", [](const auto& grid) {
+        accumulator_t<T> sum{};
+
+        for (int row = 0; row < grid.height(); ++row)
+            for (int col = 0; col < grid.width(); ++col)
+                for (int dy = -1; dy <= 1; ++dy)
+                    for (int dx = -1; dx <= 1; ++dx)
+                        if ((dx != 0 || dy != 0) && col + dx >= 0 && col + dx < grid.width() && row + dy >= 0 && row + dy < grid.height())
+                            sum += grid.at(col + dx, row + dy);
+
+        return sum;
+    });
+}
+
+template <typename T, typename CoordsType>
+void benchmark_sum_neighbors8(BenchmarkSuite& suite)
+{
+    benchmark_grid<T, CoordsType>(suite, "sum neighbors8()", [](const auto& grid) {
+        accumulator_t<T> sum{};
+
+        for (int row = 0; row < grid.height(); ++row)
+            for (int col = 0; col < grid.width(); ++col)
+                for (const auto value : grid.cell(col, row).neighbors8())
+                    sum += value;
+
+        return sum;
+    });
+}
+
+// Sum of the 4 neighbors of every cell on a torus: wrapping with % before every at(), TorusView cells and
+// a stencil over three wrapped rows.
+template <typename T, typename CoordsType>
+void benchmark_sum_torus_neighbors4(BenchmarkSuite& suite)
+{
+    benchmark_grid<T, CoordsType>(suite, "sum torus neighbors4 (modulo)", [](const auto& grid) {
+        const int size = grid.width();
+        accumulator_t<T> sum{};
+
+        for (int row = 0; row < size; ++row)
+            for (int col = 0; col < size; ++col)
+                sum += grid.at(col, (row + size - 1) % size) + grid.at((col + size - 1) % size, row) + grid.at((col + 1) % size, row) + grid.at(col, (row + 1) % size);
+
+        return sum;
+    });
+
+    benchmark_grid<T, CoordsType>(suite, "sum torus neighbors4 (TorusView cells)", [](const auto& grid) {
+        const TorusView<const Grid<T, CoordsType>> torus{grid};
+        accumulator_t<T> sum{};
+
+        for (int row = 0; row < grid.height(); ++row)
+            for (int col = 0; col < grid.width(); ++col)
+                for (const auto value : torus.cell(col, row).neighbors4())
+                    sum += value;
+
+        return sum;
+    });
+
+    benchmark_grid<T, CoordsType>(suite, "sum torus neighbors4 (TorusView rows)", [](const auto& grid) {
+        const TorusView<const Grid<T, CoordsType>> torus{grid};
+        accumulator_t<T> sum{};
+
+        for (int row = 0; row < grid.height(); ++row) {
+            const auto above = torus.row(row - 1);
+            const auto center = torus.row(row, -1, grid.width() + 2);
+            const auto below = torus.row(row + 1);
+            auto left = center.begin();
+            auto right = center.begin() + 2;
+
+            for (auto a = above.begin(), b = below.begin(); a != above.end(); ++a, ++b, ++left, ++right)
+                sum += *a + *left + *right + *b;
+        }
+
+        return sum;
+    });
+}
+
+template <typename T, typename CoordsType>
+void benchmark_gather_at(BenchmarkSuite& suite)
+{
+    for (const auto size : suite.sizes()) {
+        const auto name = fmt::format("gather 4096 at() {}: {}x{}", grid_name<T, CoordsType>(), size, size);
+
+        if (!suite.enabled(name))
+            continue;
+
+        const Grid<T, CoordsType> grid{size, size, 1};
+        const auto coords = random_coords<CoordsType>(size, size, 4096);
+        std::vector<T> values(coords.size());
+
+        suite.run(name, {.batch = coords.size()}, [&] {
+            for (std::size_t i = 0; i < coords.size(); ++i)
+                values[i] = grid.at(coords[i]);
+
+            ankerl::nanobench::doNotOptimizeAway(values);
         });
     }
 }
 
-void benchmark_sum_rows()
+template <typename T, typename CoordsType>
+void benchmark_gather(BenchmarkSuite& suite, const bool sorted_by_tile)
 {
-    for (auto size : {4, 16, 256, 1024}) {
-        const auto grid = create_grid_with_numbered_values(size, size);
+    for (const auto size : suite.sizes()) {
+        const auto name = fmt::format("gather 4096 gather(){} {}: {}x{}", sorted_by_tile ? " sorted by tile" : "", grid_name<T, CoordsType>(), size, size);
 
-        ankerl::nanobench::Bench().run(fmt::format("sum rows: {}x{}", size, size), [&] {
-            int sum = 0;
+        if (!suite.enabled(name))
+            continue;
 
-            for (auto& row : grid.rows())
-                for (auto i : row)
-                    sum += i;
+        const Grid<T, CoordsType> grid{size, size, 1};
+        auto coords = random_coords<CoordsType>(size, size, 4096);
+        std::vector<T> values(coords.size());
 
-            ankerl::nanobench::doNotOptimizeAway(sum);
+        if (sorted_by_tile)
+            sort_by_tile(std::span{coords});
+
+        suite.run(name, {.batch = coords.size()}, [&] {
+            grid.gather(coords, values);
+            ankerl::nanobench::doNotOptimizeAway(values);
         });
     }
 }
 
-void benchmark_sum_cols()
+// Grows a map from 1 to size columns one column at a time: copying into a new Grid versus ResizableGrid.
+template <typename T, typename CoordsType>
+void benchmark_grow_grid(BenchmarkSuite& suite)
 {
-    for (auto size : {4, 16, 256, 1024}) {
-        const auto grid = create_grid_with_numbered_values(size, size);
+    for (const auto size : suite.sizes()) {
+        if (size > 1024)
+            continue;
 
-        ankerl::nanobench::Bench().run(fmt::format("sum columns: {}x{}", size, size), [&] {
-            int sum = 0;
+        suite.run(fmt::format("grow by columns (copy) {}: {}x{}", grid_name<T, CoordsType>(), size, size), {.batch = static_cast<std::size_t>(size), .unit = "column"}, [&] {
+            Grid<T, CoordsType> grid{1, size};
 
-            for (auto& col : grid.cols())
-                for (auto i : col)
-                    sum += i;
+            for (int cols = 2; cols <= size; ++cols) {
+                Grid<T, CoordsType> grown{cols, size};
 
-            ankerl::nanobench::doNotOptimizeAway(sum);
+                for (int row = 0; row < size; ++row)
+                    std::copy_n(&grid.at(0, row), cols - 1, &grown.at(0, row));
+
+                grid = std::move(grown);
+            }
+
+            ankerl::nanobench::doNotOptimizeAway(grid);
+        });
+
+        suite.run(fmt::format("grow by columns (ResizableGrid) {}: {}x{}", grid_name<T, CoordsType>(), size, size), {.batch = static_cast<std::size_t>(size), .unit = "column"}, [&] {
+            ResizableGrid<T, CoordsType> grid{1, size};
+
+            for (int cols = 2; cols <= size; ++cols)
+                grid.grow_right(1);
+
+            ankerl::nanobench::doNotOptimizeAway(grid);
         });
     }
 }
 
-void benchmark_sum_cell_rows()
+// all benchmarks of Grid and its cells, cursors and views for one element and coordinates type
+template <typename T, typename CoordsType>
+void benchmark_grids(BenchmarkSuite& suite)
 {
-    for (auto size : {4, 16, 256, 1024}) {
-        const auto grid = create_grid_with_numbered_values(size, size);
+    benchmark_create_grid<T, CoordsType>(suite);
+    benchmark_create_grid_pmr<T, CoordsType>(suite);
+    benchmark_sum_baseline<T, CoordsType>(suite);
+    benchmark_sum_vector<T, CoordsType>(suite);
+    benchmark_sum_rows<T, CoordsType>(suite);
+    benchmark_sum_cols<T, CoordsType>(suite);
+    benchmark_sum_rows_segmented<T, CoordsType>(suite);
+    benchmark_sum_cols_segmented<T, CoordsType>(suite);
+    benchmark_sum_cell_rows<T, CoordsType>(suite);
+    benchmark_sum_cell_cols<T, CoordsType>(suite);
+    benchmark_sum_cursor_rows<T, CoordsType>(suite);
+    benchmark_sum_cursor_cols<T, CoordsType>(suite);
+    benchmark_sum_neighbors_at<T, CoordsType>(suite);
+    benchmark_sum_neighbors8<T, CoordsType>(suite);
+    benchmark_sum_torus_neighbors4<T, CoordsType>(suite);
+    benchmark_gather_at<T, CoordsType>(suite);
+    benchmark_gather<T, CoordsType>(suite, false);
+    benchmark_gather<T, CoordsType>(suite, true);
+    benchmark_grow_grid<T, CoordsType>(suite);
+}
 
-        ankerl::nanobench::Bench().run(fmt::format("sum cell rows: {}x{}", size, size), [&] {
-            int sum = 0;
+void benchmark_update_agents_coords(BenchmarkSuite& suite)
+{
+    const std::string name = "update 100k agents Coords: translate, clamp, manhattan distance";
+
+    if (!suite.enabled(name))
+        return;
+
+    const int size = 1024;
+    auto coords = random_coords(size, size, 100'000);
+    std::vector<int> distances(coords.size());
+
+    suite.run(name, {.batch = coords.size()}, [&] {
+        for (std::size_t i = 0; i < coords.size(); ++i) {
+            coords[i].move(1, -1);
+            coords[i] = Coords<int>{std::clamp(coords[i].x, 0, size - 1), std::clamp(coords[i].y, 0, size - 1)};
+            distances[i] = std::abs(coords[i].x - size / 2) + std::abs(coords[i].y - size / 2);
+        }
+
+        ankerl::nanobench::doNotOptimizeAway(distances);
+    });
+}
+
+void benchmark_update_agents_coords_batch(BenchmarkSuite& suite)
+{
+    const std::string name = "update 100k agents CoordsBatch: translate, clamp, manhattan distance";
+
+    if (!suite.enabled(name))
+        return;
+
+    const int size = 1024;
+    const auto coords = random_coords(size, size, 100'000);
+    CoordsBatch<int> batch{std::span{coords}};
+    std::vector<int> distances(coords.size());
+
+    suite.run(name, {.batch = coords.size()}, [&] {
+        batch.translate(1, -1);
+        batch.clamp({0, 0}, {size - 1, size - 1});
+        batch.manhattan_distances({size / 2, size / 2}, distances);
+
+        ankerl::nanobench::doNotOptimizeAway(distances);
+    });
+}
+
+template <typename CoordsType>
+void benchmark_sort_coords(BenchmarkSuite& suite, const char* name)
+{
+    const auto sort_name = fmt::format("sort 100k {}", name);
+
+    if (!suite.enabled(sort_name))
+        return;
+
+    const auto coords = random_coords(1024, 1024, 100'000);
+    std::vector<CoordsType> sorted(coords.size());
+
+    suite.run(sort_name, {.batch = coords.size()}, [&] {
+        std::transform(coords.begin(), coords.end(), sorted.begin(), [](const Coords<int>& c) { return CoordsType{static_cast<short>(c.x), static_cast<short>(c.y)}; });
+        std::sort(sorted.begin(), sorted.end());
+        ankerl::nanobench::doNotOptimizeAway(sorted);
+    });
+}
 
-            for (int row = 0; row < grid.height(); ++row) {
-                auto cell = grid.cell(row, 0);
+template <typename MapType>
+void benchmark_coords_map(BenchmarkSuite& suite, const char* name)
+{
+    const auto insert_name = fmt::format("insert 100k {}", name);
+    const auto lookup_name = fmt::format("lookup 100k {}", name);
+
+    if (!suite.enabled(insert_name) && !suite.enabled(lookup_name))
+        return;
+
+    const auto keys = random_coords(1024, 1024, 100'000);
+    const auto lookups = random_coords(1024, 1024, 100'000);
+
+    suite.run(insert_name, {.batch = keys.size()}, [&] {
+        MapType map;
+
+        for (std::size_t i = 0; i < keys.size(); ++i)
+            map[keys[i]] = static_cast<int>(i);
+
+        ankerl::nanobench::doNotOptimizeAway(map);
+    });
+
+    if (!suite.enabled(lookup_name))
+        return;
+
+    MapType map;
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        map[keys[i]] = static_cast<int>(i);
+
+    suite.run(lookup_name, {.batch = lookups.size()}, [&] {
+        std::size_t found = 0;
+
+        for (const auto& key : lookups)
+            found += map.count(key);
+
+        ankerl::nanobench::doNotOptimizeAway(found);
+    });
+}
 
-                while (cell.col() < grid.width()) {
-                    sum += cell.value();
-                    cell.move_right();
+void benchmark_volume_sum_z_lines(BenchmarkSuite& suite)
+{
+    for (auto size : {16, 64, 256}) {
+        const auto one_by_one_name = fmt::format("sum z lines one by one: {}x{}x{}", size, size, size);
+        const auto reduce_name = fmt::format("sum z lines reduce_z(): {}x{}x{}", size, size, size);
+
+        if (!suite.enabled(one_by_one_name) && !suite.enabled(reduce_name))
+            continue;
+
+        const Volume<int> volume{size, size, size, 1};
+        Grid<int> sums{size, size};
+
+        suite.run(one_by_one_name, {.batch = static_cast<std::size_t>(volume.size())}, [&] {
+            for (int y = 0; y < size; ++y) {
+                for (int x = 0; x < size; ++x) {
+                    const auto line = volume.z_line(x, y);
+                    sums.at(x, y) = std::accumulate(line.begin(), line.end(), 0);
                 }
             }
 
-            ankerl::nanobench::doNotOptimizeAway(sum);
+            ankerl::nanobench::doNotOptimizeAway(sums);
+        });
+
+        suite.run(reduce_name, {.batch = static_cast<std::size_t>(volume.size())}, [&] {
+            ankerl::nanobench::doNotOptimizeAway(volume.reduce_z(0, std::plus<>{}));
         });
     }
 }
 
-void benchmark_sum_cell_cols()
+template <typename VolumeType>
+void benchmark_volume_stencil(BenchmarkSuite& suite, const char* name)
 {
-    for (auto size : {4, 16, 256, 1024}) {
-        const auto grid = create_grid_with_numbered_values(size, size);
+    for (auto size : {16, 64, 256}) {
+        const auto stencil_name = fmt::format("6 neighbor stencil {}: {}x{}x{}", name, size, size, size);
 
-        ankerl::nanobench::Bench().run(fmt::format("sum cell cols: {}x{}", size, size), [&] {
-            int sum = 0;
+        if (!suite.enabled(stencil_name))
+            continue;
 
-            for (int col = 0; col < grid.width(); ++col) {
-                auto cell = grid.cell(0, col);
+        VolumeType volume{size, size, size};
+        const auto inner = static_cast<std::size_t>(size - 2);
 
-                while (cell.row() < grid.height()) {
-                    sum += cell.value();
-                    cell.move_down();
-                }
-            }
+        suite.run(stencil_name, {.batch = inner * inner * inner}, [&] {
+            int sum = 0;
+
+            for (int z = 1; z < size - 1; ++z)
+                for (int y = 1; y < size - 1; ++y)
+                    for (int x = 1; x < size - 1; ++x)
+                        sum += volume.at(x - 1, y, z) + volume.at(x + 1, y, z) + volume.at(x, y - 1, z) + volume.at(x, y + 1, z) + volume.at(x, y, z - 1) + volume.at(x, y, z + 1);
 
             ankerl::nanobench::doNotOptimizeAway(sum);
         });
     }
 }
 
-int main()
+template <typename NdGridType, typename... Extents>
+void benchmark_nd_grid_sum(BenchmarkSuite& suite, const char* name, const Extents... extents)
 {
-    benchmark_create_grid();
-    benchmark_sum_baseline();
-    benchmark_sum_vector();
-    benchmark_sum_rows();
-    benchmark_sum_cols();
-    benchmark_sum_cell_rows();
-    benchmark_sum_cell_cols();
+    const auto call_name = fmt::format("sum NdGrid<int, 3> operator() {}: 64x64x64", name);
+    const auto for_each_name = fmt::format("sum NdGrid<int, 3> for_each_indexed() {}: 64x64x64", name);
+
+    if (!suite.enabled(call_name) && !suite.enabled(for_each_name))
+        return;
+
+    NdGridType grid{extents...};
+    std::fill(grid.begin(), grid.end(), 1);
+
+    suite.run(call_name, {.batch = static_cast<std::size_t>(grid.size())}, [&] {
+        int sum = 0;
+
+        for (int z = 0; z < grid.template extent<2>(); ++z)
+            for (int y = 0; y < grid.template extent<1>(); ++y)
+                for (int x = 0; x < grid.template extent<0>(); ++x)
+                    sum += grid(x, y, z);
+
+        ankerl::nanobench::doNotOptimizeAway(sum);
+    });
+
+    suite.run(for_each_name, {.batch = static_cast<std::size_t>(grid.size())}, [&] {
+        int sum = 0;
+        grid.for_each_indexed([&](const auto&, const int value) { sum += value; });
+        ankerl::nanobench::doNotOptimizeAway(sum);
+    });
+}
+
+// Random and column access in a 256 MB Grid, where most accesses miss the TLB with regular 4 KB pages.
+template <typename Allocator>
+void benchmark_huge_pages(BenchmarkSuite& suite, const char* name)
+{
+    constexpr int size = 8192;
+    constexpr std::size_t accesses = 1 << 20;
+
+    const auto random_name = fmt::format("random access ({}): {}x{}", name, size, size);
+    const auto column_name = fmt::format("column access ({}): {}x{}", name, size, size);
+
+    if (!suite.enabled(random_name) && !suite.enabled(column_name))
+        return;
+
+    const Grid<int, Coords<int>, Allocator> grid{size, size, 1};
+    const auto coords = random_coords(size, size, accesses);
+
+    suite.run(random_name, {.batch = accesses, .unit = "access"}, [&] {
+        int sum = 0;
+
+        for (const auto& c : coords)
+            sum += grid.at(c);
+
+        ankerl::nanobench::doNotOptimizeAway(sum);
+    });
+
+    suite.run(column_name, {.batch = static_cast<std::size_t>(grid.size()), .unit = "access", .epochs = 5}, [&] {
+        int sum = 0;
+
+        for (const auto& col : grid.cols())
+            for (const auto i : col)
+                sum += i;
+
+        ankerl::nanobench::doNotOptimizeAway(sum);
+    });
+}
+
+int main(int argc, char* argv[])
+{
+    const auto options = BenchmarkSuite::parse_options(std::span{argv, static_cast<std::size_t>(argc)});
+
+    if (!options)
+        return EXIT_FAILURE;
+
+    BenchmarkSuite suite{*options};
+
+    benchmark_grids<int, Coords<short>>(suite);
+    benchmark_grids<std::uint8_t, Coords<short>>(suite);
+    benchmark_grids<double, Coords<int>>(suite);
+    benchmark_update_agents_coords(suite);
+    benchmark_update_agents_coords_batch(suite);
+    benchmark_sort_coords<Coords<short>>(suite, "Coords<short>");
+    benchmark_sort_coords<PackedCoords<short>>(suite, "PackedCoords<short>");
+    benchmark_sort_coords<Coords<int>>(suite, "Coords<int>");
+    benchmark_sort_coords<PackedCoords<int, short>>(suite, "PackedCoords<int, short>");
+    benchmark_coords_map<std::map<Coords<int>, int>>(suite, "std::map");
+    benchmark_coords_map<std::unordered_map<Coords<int>, int>>(suite, "std::unordered_map");
+    benchmark_coords_map<CoordsMap<Coords<int>, int>>(suite, "CoordsMap");
+    benchmark_volume_sum_z_lines(suite);
+    benchmark_volume_stencil<Volume<int>>(suite, "Volume");
+    benchmark_volume_stencil<BrickedVolume<int>>(suite, "BrickedVolume");
+    benchmark_nd_grid_sum<NdGrid<int, 3>>(suite, "dynamic extents", 64, 64, 64);
+    benchmark_nd_grid_sum<NdGrid<int, 3, 64, 64, 64>>(suite, "static extents");
+
+    if (suite.options().huge_pages) {
+        benchmark_huge_pages<std::allocator<int>>(suite, "regular pages");
+        benchmark_huge_pages<HugePageAllocator<int>>(suite, "huge pages");
+    }
+
+    return suite.finish() ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -0,0 +1,319 @@
+#pragma once
+
+#include <cassert>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <istream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+// Times of all epochs of one benchmark, in seconds per iteration.
+struct BenchmarkSamples {
+    std::string name;
+    std::vector<double> elapsed;
+};
+
+enum class BenchmarkChange {
+    none,
+    regression,
+    improvement
+};
+
+// Relative change of the (geometric) mean time with its 99% confidence interval, 0.1 means 10% slower.
+struct BenchmarkComparison {
+    double change;
+    double lower;
+    double upper;
+    BenchmarkChange result;
+};
+
+// Reads the results of a nanobench json file like the ones written by grid_benchmark --json, nothing if it is invalid.
+// Only the names and the elapsed times of the measurements are kept.
+class BenchmarkJsonReader {
+public:
+    [[nodiscard]] static std::optional<std::vector<BenchmarkSamples>> read(std::istream& in);
+    [[nodiscard]] static std::optional<std::vector<BenchmarkSamples>> read(std::string_view text);
+
+private:
+    std::string_view text_;
+    std::size_t pos_ = 0;
+
+    explicit BenchmarkJsonReader(const std::string_view text) : text_{text} { }
+
+    [[nodiscard]] bool parse_results(std::vector<BenchmarkSamples>& results);
+    [[nodiscard]] bool parse_result(BenchmarkSamples& samples);
+    [[nodiscard]] bool parse_measurement(std::vector<double>& elapsed);
+
+    // calls parse_member(key) for each member of an object
+    template <typename ParseMember>
+    [[nodiscard]] bool parse_object(ParseMember parse_member);
+
+    // calls parse_element() for each element of an array
+    template <typename ParseElement>
+    [[nodiscard]] bool parse_array(ParseElement parse_element);
+
+    [[nodiscard]] bool parse_string(std::string& str);
+    [[nodiscard]] bool parse_number(double& number);
+    [[nodiscard]] bool skip_value();
+
+    [[nodiscard]] bool consume(char c);
+    [[nodiscard]] char peek();
+};
+
+// Critical value of Student's t-distribution for a two-sided 99% confidence interval, from the normal quantile
+// with the Cornish-Fisher expansion, which is accurate to about 0.01 for 3 and more degrees of freedom.
+[[nodiscard]] inline double student_t_critical_value(const double degrees_of_freedom)
+{
+    constexpr double z = 2.5758293035489004;
+    constexpr double z3 = z * z * z;
+    constexpr double z5 = z3 * z * z;
+    constexpr double z7 = z5 * z * z;
+    constexpr double z9 = z7 * z * z;
+    const double df = degrees_of_freedom;
+
+    return z + (z3 + z) / (4.0 * df) + (5.0 * z5 + 16.0 * z3 + 3.0 * z) / (96.0 * df * df) + (3.0 * z7 + 19.0 * z5 + 17.0 * z3 - 15.0 * z) / (384.0 * df * df * df)
+        + (79.0 * z9 + 776.0 * z7 + 1482.0 * z5 - 1920.0 * z3 - 945.0 * z) / (92160.0 * df * df * df * df);
+}
+
+// Welch's t-test on the logarithms of the times, so the confidence interval is one of the ratio of the times and
+// single slow epochs (the times are skewed to the right) have less influence. A change is only reported if the
+// interval does not contain 0 and the change is larger than the threshold, for example 0.05 for 5%.
+[[nodiscard]] inline BenchmarkComparison compare_benchmark(const BenchmarkSamples& baseline, const BenchmarkSamples& current, const double threshold)
+{
+    struct LogStats {
+        double mean = 0.0;
+        double variance_of_mean = 0.0;
+        double n = 0.0;
+    };
+
+    const auto log_stats = [](const std::vector<double>& elapsed) {
+        LogStats stats;
+        stats.n = static_cast<double>(elapsed.size());
+
+        for (const double e : elapsed)
+            stats.mean += std::log(e) / stats.n;
+
+        if (elapsed.size() > 1) {
+            for (const double e : elapsed)
+                stats.variance_of_mean += (std::log(e) - stats.mean) * (std::log(e) - stats.mean);
+
+            stats.variance_of_mean /= (stats.n - 1.0) * stats.n;
+        }
+
+        return stats;
+    };
+
+    assert(!baseline.elapsed.empty() && !current.elapsed.empty());
+
+    const LogStats a = log_stats(baseline.elapsed);
+    const LogStats b = log_stats(current.elapsed);
+    const double diff = b.mean - a.mean;
+    const double variance = a.variance_of_mean + b.variance_of_mean;
+    double margin = 0.0;
+
+    if (variance > 0.0) {
+        // Welch-Satterthwaite, a sample without variance (or a single epoch) contributes no degrees of freedom
+        const auto df_part = [](const LogStats& s) { return s.n > 1.0 ? s.variance_of_mean * s.variance_of_mean / (s.n - 1.0) : 0.0; };
+        const double df = variance * variance / (df_part(a) + df_part(b));
+        margin = student_t_critical_value(df) * std::sqrt(variance);
+    }
+
+    BenchmarkComparison comparison{std::expm1(diff), std::expm1(diff - margin), std::expm1(diff + margin), BenchmarkChange::none};
+
+    if (comparison.lower > 0.0 && comparison.change > threshold)
+        comparison.result = BenchmarkChange::regression;
+    else if (comparison.upper < 0.0 && comparison.change < -threshold)
+        comparison.result = BenchmarkChange::improvement;
+
+    return comparison;
+}
+
+inline std::optional<std::vector<BenchmarkSamples>> BenchmarkJsonReader::read(std::istream& in)
+{
+    std::ostringstream text;
+    text << in.rdbuf();
+    return read(std::string_view{text.str()});
+}
+
+inline std::optional<std::vector<BenchmarkSamples>> BenchmarkJsonReader::read(const std::string_view text)
+{
+    BenchmarkJsonReader reader{text};
+    std::vector<BenchmarkSamples> results;
+
+    const bool valid = reader.parse_object([&](const std::string& key) { return key == "results" ? reader.parse_results(results) : reader.skip_value(); });
+
+    if (!valid || reader.peek() != '\0')
+        return std::nullopt;
+
+    return results;
+}
+
+inline bool BenchmarkJsonReader::parse_results(std::vector<BenchmarkSamples>& results)
+{
+    return parse_array([&] {
+        BenchmarkSamples samples;
+
+        if (!parse_result(samples))
+            return false;
+
+        if (!samples.elapsed.empty())
+            results.push_back(std::move(samples));
+
+        return true;
+    });
+}
+
+inline bool BenchmarkJsonReader::parse_result(BenchmarkSamples& samples)
+{
+    return parse_object([&](const std::string& key) {
+        if (key == "name")
+            return parse_string(samples.name);
+        if (key == "measurements")
+            return parse_array([&] { return parse_measurement(samples.elapsed); });
+
+        return skip_value();
+    });
+}
+
+inline bool BenchmarkJsonReader::parse_measurement(std::vector<double>& elapsed)
+{
+    return parse_object([&](const std::string& key) {
+        if (key != "elapsed")
+            return skip_value();
+
+        double e = 0.0;
+
+        if (!parse_number(e))
+            return false;
+
+        // the comparison needs the logarithm
+        if (e > 0.0)
+            elapsed.push_back(e);
+
+        return true;
+    });
+}
+
+template <typename ParseMember>
+bool BenchmarkJsonReader::parse_object(ParseMember parse_member)
+{
+    if (!consume('{'))
+        return false;
+    if (consume('}'))
+        return true;
+
+    do {
+        std::string key;
+
+        if (!parse_string(key) || !consume(':') || !parse_member(key))
+            return false;
+    } while (consume(','));
+
+    return consume('}');
+}
+
+template <typename ParseElement>
+bool BenchmarkJsonReader::parse_array(ParseElement parse_element)
+{
+    if (!consume('['))
+        return false;
+    if (consume(']'))
+        return true;
+
+    do {
+        if (!parse_element())
+            return false;
+    } while (consume(','));
+
+    return consume(']');
+}
+
+inline bool BenchmarkJsonReader::parse_string(std::string& str)
+{
+    if (!consume('"'))
+        return false;
+
+    str.clear();
+
+    while (pos_ < text_.size() && text_[pos_] != '"') {
+        char c = text_[pos_++];
+
+        // only simple escapes, \u sequences are kept as they are
+        if (c == '\\' && pos_ < text_.size()) {
+            c = text_[pos_++];
+
+            if (c == 'n')
+                c = '\n';
+            else if (c == 't')
+                c = '\t';
+            else if (c == 'u')
+                str += '\\';
+        }
+
+        str += c;
+    }
+
+    return pos_++ < text_.size();
+}
+
+inline bool BenchmarkJsonReader::parse_number(double& number)
+{
+    if (peek() == '\0')
+        return false;
+
+    const auto [ptr, ec] = std::from_chars(text_.data() + pos_, text_.data() + text_.size(), number);
+
+    if (ec != std::errc{})
+        return false;
+
+    pos_ = static_cast<std::size_t>(ptr - text_.data());
+    return true;
+}
+
+inline bool BenchmarkJsonReader::skip_value()
+{
+    const char c = peek();
+
+    if (c == '{')
+        return parse_object([&](const std::string&) { return skip_value(); });
+    if (c == '[')
+        return parse_array([&] { return skip_value(); });
+    if (c == '"') {
+        std::string str;
+        return parse_string(str);
+    }
+
+    for (const std::string_view literal : {"true", "false", "null"}) {
+        if (text_.substr(pos_, literal.size()) == literal) {
+            pos_ += literal.size();
+            return true;
+        }
+    }
+
+    double number = 0.0;
+    return parse_number(number);
+}
+
+inline bool BenchmarkJsonReader::consume(const char c)
+{
+    if (peek() != c)
+        return false;
+
+    ++pos_;
+    return true;
+}
+
+// skips whitespace, returns the next character or '\0' at the end
+inline char BenchmarkJsonReader::peek()
+{
+    while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\n' || text_[pos_] == '\r' || text_[pos_] == '\t'))
+        ++pos_;
+
+    return pos_ < text_.size() ? text_[pos_] : '\0';
+}
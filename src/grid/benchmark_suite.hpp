@@ -0,0 +1,381 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <regex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "nanobench.h"
+
+#include "fmt/core.h"
+
+#include "allocation_counter.hpp"
+#include "benchmark_comparison.hpp"
+#include "coords.hpp"
+#include "perf_counters.hpp"
+
+enum class BenchmarkFormat {
+    text,
+    json,
+    csv
+};
+
+struct BenchmarkOptions {
+    std::optional<std::regex> filter;
+    std::vector<int> sizes{4, 16, 256, 1024};
+    BenchmarkFormat format = BenchmarkFormat::text;
+    std::string output;  // file for the json or csv results, stdout if empty
+    bool huge_pages = false;
+    bool counters = false;
+    bool allocations = false;
+    std::optional<std::vector<BenchmarkSamples>> baseline;  // results of an earlier run to compare against
+    double threshold = 0.05;                                 // smallest relative change reported by the comparison
+};
+
+// Settings of a single benchmark run, the defaults are the ones of nanobench.
+// The hardware counters are reported per batch element, for example per cell.
+struct BenchmarkRunOptions {
+    std::size_t batch = 1;
+    const char* unit = "op";
+    std::size_t epochs = 11;
+};
+
+// Names of the element and coordinates types in benchmark names.
+template <typename T>
+struct TypeName;
+
+template <>
+struct TypeName<std::uint8_t> {
+    static std::string name() { return "uint8_t"; }
+};
+
+template <>
+struct TypeName<short> {
+    static std::string name() { return "short"; }
+};
+
+template <>
+struct TypeName<int> {
+    static std::string name() { return "int"; }
+};
+
+template <>
+struct TypeName<float> {
+    static std::string name() { return "float"; }
+};
+
+template <>
+struct TypeName<double> {
+    static std::string name() { return "double"; }
+};
+
+template <typename CoordinatesType>
+struct TypeName<Coords<CoordinatesType>> {
+    static std::string name() { return fmt::format("Coords<{}>", TypeName<CoordinatesType>::name()); }
+};
+
+// Runs the benchmarks selected on the command line and collects all results in one nanobench::Bench,
+// which renders them as json or csv at the end so they can be compared across commits.
+// With --counters each benchmark is repeated for a moment with perf_event_open counters (cache and TLB misses
+// on top of what nanobench reports) and the counts per batch element are printed below its result.
+// With --allocations each benchmark is run once more while counting its allocations, hot paths should show none.
+// With --baseline the results are compared to the json results of an earlier run, significant slowdowns
+// make finish() fail so the benchmark can be used as a regression gate.
+class BenchmarkSuite {
+public:
+    explicit BenchmarkSuite(BenchmarkOptions options);
+
+    BenchmarkSuite(const BenchmarkSuite&) = delete;
+    BenchmarkSuite& operator=(const BenchmarkSuite&) = delete;
+
+    // parses the command line, prints the usage and returns nothing for --help or invalid arguments
+    [[nodiscard]] static std::optional<BenchmarkOptions> parse_options(std::span<char*> args);
+
+    [[nodiscard]] const BenchmarkOptions& options() const { return options_; }
+
+    // sizes (width and height) of square grids
+    [[nodiscard]] const std::vector<int>& sizes() const { return options_.sizes; }
+
+    // benchmarks can check this before an expensive setup
+    [[nodiscard]] bool enabled(const std::string& name) const { return !options_.filter || std::regex_search(name, *options_.filter); }
+
+    template <typename Op>
+    void run(const std::string& name, Op&& op) { run(name, BenchmarkRunOptions{}, std::forward<Op>(op)); }
+
+    template <typename Op>
+    void run(const std::string& name, const BenchmarkRunOptions& run_options, Op&& op);
+
+    // writes the collected results in the selected format and compares them to the baseline,
+    // returns false if the output file could not be written or a benchmark got significantly slower
+    bool finish() const;
+
+private:
+    BenchmarkOptions options_;
+    ankerl::nanobench::Bench bench_;
+    std::optional<PerfCounters> counters_;
+
+    template <typename Op>
+    void measure_counters(const std::string& name, const BenchmarkRunOptions& run_options, Op& op);
+
+    // the table goes to stdout, unless stdout is used for the json or csv results
+    [[nodiscard]] std::ostream& table_output() const { return options_.format != BenchmarkFormat::text && options_.output.empty() ? std::cerr : std::cout; }
+
+    [[nodiscard]] bool compare_to_baseline() const;
+
+    static void print_usage(std::ostream& out);
+    [[nodiscard]] static std::optional<std::vector<int>> parse_sizes(std::string_view sizes);
+};
+
+inline BenchmarkSuite::BenchmarkSuite(BenchmarkOptions options) : options_{std::move(options)}
+{
+    // without an output file the results are written to stdout instead of the table
+    if (options_.format != BenchmarkFormat::text && options_.output.empty())
+        bench_.output(nullptr);
+
+    if (options_.counters) {
+        counters_.emplace();
+
+        if (!counters_->any_available())
+            std::cerr << "no hardware counters available, check /proc/sys/kernel/perf_event_paranoid\n";
+    }
+
+    // the benchmarks allocate through the standard allocators, without the hook every count would be 0
+    if (options_.allocations && !AllocationCounter::operator_new_hooked()) {
+        std::cerr << "operator new is not replaced, --allocations needs a build with GRID_BENCHMARK_COUNT_ALLOCATIONS=ON\n";
+        options_.allocations = false;
+    }
+}
+
+template <typename Op>
+void BenchmarkSuite::run(const std::string& name, const BenchmarkRunOptions& run_options, Op&& op)
+{
+    if (!enabled(name))
+        return;
+
+    bench_.batch(run_options.batch).unit(run_options.unit).epochs(run_options.epochs).run(name, op);
+
+    if (counters_ && counters_->any_available())
+        measure_counters(name, run_options, op);
+
+    if (options_.allocations) {
+        const AllocationStats allocations = count_allocations(op);
+        table_output() << fmt::format("|   allocations per iteration: {}, {} bytes | {}\n", allocations.count, allocations.bytes, name);
+    }
+}
+
+template <typename Op>
+void BenchmarkSuite::measure_counters(const std::string& name, const BenchmarkRunOptions& run_options, Op& op)
+{
+    // repeat for about 50 ms, based on the time per iteration nanobench just measured
+    const double seconds = bench_.results().back().median(ankerl::nanobench::Result::Measure::elapsed);
+    const auto iterations = static_cast<std::uint64_t>(std::clamp(0.05 / std::max(seconds, 1e-9), 1.0, 1e6));
+
+    counters_->start();
+
+    for (std::uint64_t i = 0; i < iterations; ++i)
+        op();
+
+    counters_->stop();
+
+    const double elements = static_cast<double>(iterations) * static_cast<double>(run_options.batch);
+    std::string line = fmt::format("|   per {}:", run_options.unit);
+
+    for (const auto counter : PerfCounters::all_counters)
+        if (const auto value = counters_->value(counter))
+            line += fmt::format(" {:.3f} {},", *value / elements, PerfCounters::name(counter));
+
+    const auto cycles = counters_->value(PerfCounter::cycles);
+    const auto instructions = counters_->value(PerfCounter::instructions);
+
+    if (cycles && instructions && *cycles > 0)
+        line += fmt::format(" {:.2f} IPC,", *instructions / *cycles);
+
+    line.back() = ' ';
+    table_output() << line << "| " << name << "\n";
+}
+
+inline bool BenchmarkSuite::finish() const
+{
+    const bool no_regressions = compare_to_baseline();
+
+    if (options_.format == BenchmarkFormat::text)
+        return no_regressions;
+
+    const char* const mustache_template = options_.format == BenchmarkFormat::json ? ankerl::nanobench::templates::json() : ankerl::nanobench::templates::csv();
+
+    if (options_.output.empty()) {
+        ankerl::nanobench::render(mustache_template, bench_, std::cout);
+        return no_regressions;
+    }
+
+    std::ofstream out{options_.output};
+    ankerl::nanobench::render(mustache_template, bench_, out);
+
+    if (!out) {
+        std::cerr << "could not write " << options_.output << "\n";
+        return false;
+    }
+
+    return no_regressions;
+}
+
+// prints the change of every benchmark that is also in the baseline, returns false if any got significantly slower
+inline bool BenchmarkSuite::compare_to_baseline() const
+{
+    if (!options_.baseline)
+        return true;
+
+    std::ostream& out = table_output();
+    int regressions = 0;
+    int improvements = 0;
+
+    out << "\n|       change | 99% confidence interval |             | benchmark\n";
+
+    for (const auto& result : bench_.results()) {
+        const std::string& name = result.config().mBenchmarkName;
+        const auto baseline = std::find_if(options_.baseline->begin(), options_.baseline->end(), [&](const auto& samples) { return samples.name == name; });
+
+        if (baseline == options_.baseline->end()) {
+            out << fmt::format("| {:>12} | {:>23} | {:<11} | {}\n", "", "", "new", name);
+            continue;
+        }
+
+        BenchmarkSamples current{name, {}};
+
+        // nanobench stores the elapsed time per iteration, like in the json results of the baseline
+        for (std::size_t i = 0; i < result.size(); ++i)
+            current.elapsed.push_back(result.get(i, ankerl::nanobench::Result::Measure::elapsed));
+
+        const BenchmarkComparison comparison = compare_benchmark(*baseline, current, options_.threshold);
+        const char* const verdict = comparison.result == BenchmarkChange::regression ? "REGRESSION" : comparison.result == BenchmarkChange::improvement ? "improvement" : "";
+
+        regressions += comparison.result == BenchmarkChange::regression ? 1 : 0;
+        improvements += comparison.result == BenchmarkChange::improvement ? 1 : 0;
+
+        out << fmt::format("| {:>+11.1f}% | {:>+10.1f}% .. {:>+8.1f}% | {:<11} | {}\n", 100.0 * comparison.change, 100.0 * comparison.lower, 100.0 * comparison.upper, verdict, name);
+    }
+
+    out << fmt::format("\n{} regressions and {} improvements larger than {:.1f}%\n", regressions, improvements, 100.0 * options_.threshold);
+    return regressions == 0;
+}
+
+inline std::optional<BenchmarkOptions> BenchmarkSuite::parse_options(const std::span<char*> args)
+{
+    BenchmarkOptions options;
+
+    for (std::size_t i = 1; i < args.size(); ++i) {
+        const std::string_view arg{args[i]};
+        const bool has_value = i + 1 < args.size();
+
+        if (arg == "--filter" && has_value) {
+            try {
+                options.filter = std::regex{args[++i]};
+            } catch (const std::regex_error& e) {
+                std::cerr << "invalid filter: " << e.what() << "\n";
+                return std::nullopt;
+            }
+        } else if (arg == "--sizes" && has_value) {
+            auto sizes = parse_sizes(args[++i]);
+
+            if (!sizes) {
+                print_usage(std::cerr);
+                return std::nullopt;
+            }
+
+            options.sizes = std::move(*sizes);
+        } else if (arg == "--json") {
+            options.format = BenchmarkFormat::json;
+        } else if (arg == "--csv") {
+            options.format = BenchmarkFormat::csv;
+        } else if (arg == "--output" && has_value) {
+            options.output = args[++i];
+        } else if (arg == "--huge-pages") {
+            options.huge_pages = true;
+        } else if (arg == "--counters") {
+            options.counters = true;
+        } else if (arg == "--allocations") {
+            options.allocations = true;
+        } else if (arg == "--baseline" && has_value) {
+            std::ifstream in{args[++i]};
+            options.baseline = BenchmarkJsonReader::read(in);
+
+            if (!in || !options.baseline) {
+                std::cerr << "could not read benchmark results from " << args[i] << "\n";
+                return std::nullopt;
+            }
+        } else if (arg == "--threshold" && has_value) {
+            const std::string_view value{args[++i]};
+            double percent = 0.0;
+            const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), percent);
+
+            if (ec != std::errc{} || ptr != value.data() + value.size() || percent < 0.0) {
+                print_usage(std::cerr);
+                return std::nullopt;
+            }
+
+            options.threshold = percent / 100.0;
+        } else {
+            print_usage(arg == "--help" ? std::cout : std::cerr);
+            return std::nullopt;
+        }
+    }
+
+    return options;
+}
+
+// a preset or a comma separated list of sizes
+inline std::optional<std::vector<int>> BenchmarkSuite::parse_sizes(const std::string_view sizes)
+{
+    // small: fits into L1/L2, default: up to 4 MB (L2/L3), large: 64 MB (exceeds L3),
+    // huge: 1 GB (exceeds any cache and the TLB reach, needs a few GB of RAM)
+    if (sizes == "small")
+        return std::vector{4, 16};
+    if (sizes == "default")
+        return std::vector{4, 16, 256, 1024};
+    if (sizes == "large")
+        return std::vector{4, 16, 256, 1024, 4096};
+    if (sizes == "huge")
+        return std::vector{4, 16, 256, 1024, 4096, 16384};
+
+    std::vector<int> result;
+    std::size_t pos = 0;
+
+    while (pos <= sizes.size()) {
+        const std::size_t end = std::min(sizes.find(',', pos), sizes.size());
+        int size = 0;
+        const auto [ptr, ec] = std::from_chars(sizes.data() + pos, sizes.data() + end, size);
+
+        if (ec != std::errc{} || ptr != sizes.data() + end || size <= 0)
+            return std::nullopt;
+
+        result.push_back(size);
+        pos = end + 1;
+    }
+
+    return result;
+}
+
+inline void BenchmarkSuite::print_usage(std::ostream& out)
+{
+    out << "usage: grid_benchmark [options]\n"
+           "  --filter <regex>   run only benchmarks whose name matches the regular expression\n"
+           "  --sizes <sizes>    grid sizes: small, default, large (exceeds L3), huge (1 GB grids)\n"
+           "                     or a comma separated list like 64,512\n"
+           "  --json, --csv      write the results as nanobench json or csv\n"
+           "  --output <file>    write the json or csv results to a file instead of stdout\n"
+           "  --huge-pages       also run the huge page benchmarks (allocates 512 MB)\n"
+           "  --counters         report cycles, instructions, branch, L1D, LLC and dTLB misses per element (Linux)\n"
+           "  --allocations      report the number and bytes of allocations of one benchmark iteration\n"
+           "  --baseline <file>  compare to the results of an earlier --json run, fails on significant slowdowns\n"
+           "  --threshold <pct>  smallest change in percent the comparison reports (default 5)\n";
+}
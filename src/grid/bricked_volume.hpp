@@ -0,0 +1,138 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "volume.hpp"
+
+// Volume stored in cubic bricks of BrickSize^3 values, each brick contiguous in memory. Neighbors in all three
+// directions are (mostly) inside the same brick, so stencils and traversals along y or z stay within a few cache
+// lines and pages, where a linear Volume jumps width or width * height values per step.
+// The volume is padded to whole bricks, at() maps coordinates with shifts and masks.
+template <typename T = int, typename CoordsType = Coords3<int>, int BrickSize = 8>
+class BrickedVolume {
+public:
+    using size_type = int;
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using coords_type = CoordsType;
+
+    static_assert(BrickSize > 0 && (BrickSize & (BrickSize - 1)) == 0, "brick size must be a power of two");
+
+    static constexpr size_type brick_size = BrickSize;
+    static constexpr auto brick_volume = static_cast<std::size_t>(BrickSize * BrickSize * BrickSize);
+
+    BrickedVolume(size_type cols, size_type rows, size_type slices, const T& value = T{});
+    explicit BrickedVolume(const Volume<T, CoordsType>& volume);
+
+    size_type width() const { return cols_; }
+    size_type height() const { return rows_; }
+    size_type depth() const { return slices_; }
+
+    size_type bricks_width() const { return bricks_x_; }
+    size_type bricks_height() const { return bricks_y_; }
+    size_type bricks_depth() const { return bricks_z_; }
+
+    [[nodiscard]] reference at(size_type col, size_type row, size_type slice) { return data_[idx(col, row, slice)]; }
+    [[nodiscard]] const_reference at(size_type col, size_type row, size_type slice) const { return data_[idx(col, row, slice)]; }
+
+    [[nodiscard]] reference at(const coords_type& coords) { return data_[idx(coords.col(), coords.row(), coords.slice())]; }
+    [[nodiscard]] const_reference at(const coords_type& coords) const { return data_[idx(coords.col(), coords.row(), coords.slice())]; }
+
+    // values of one brick, x fastest, then y, then z (including padding at the far borders)
+    [[nodiscard]] std::span<T, brick_volume> brick(size_type brick_col, size_type brick_row, size_type brick_slice);
+    [[nodiscard]] std::span<const T, brick_volume> brick(size_type brick_col, size_type brick_row, size_type brick_slice) const;
+
+    [[nodiscard]] Volume<T, CoordsType> to_volume() const;
+
+private:
+    static constexpr int shift = std::countr_zero(static_cast<unsigned>(BrickSize));
+    static constexpr int mask = BrickSize - 1;
+
+    size_type cols_;
+    size_type rows_;
+    size_type slices_;
+    size_type bricks_x_;
+    size_type bricks_y_;
+    size_type bricks_z_;
+
+    std::vector<T> data_;
+
+    [[nodiscard]] std::size_t brick_offset(size_type brick_col, size_type brick_row, size_type brick_slice) const;
+    [[nodiscard]] inline std::size_t idx(size_type col, size_type row, size_type slice) const;
+};
+
+template <typename T, typename CoordsType, int BrickSize>
+BrickedVolume<T, CoordsType, BrickSize>::BrickedVolume(const size_type cols, const size_type rows, const size_type slices, const T& value)
+{
+    assert(cols > 0 && rows > 0 && slices > 0);
+    assert(cols - 1 <= coords_type::max());
+    assert(rows - 1 <= coords_type::max());
+    assert(slices - 1 <= coords_type::max());
+    cols_ = cols;
+    rows_ = rows;
+    slices_ = slices;
+    bricks_x_ = (cols + BrickSize - 1) / BrickSize;
+    bricks_y_ = (rows + BrickSize - 1) / BrickSize;
+    bricks_z_ = (slices + BrickSize - 1) / BrickSize;
+    data_ = std::vector<T>(static_cast<std::size_t>(bricks_x_) * static_cast<std::size_t>(bricks_y_) * static_cast<std::size_t>(bricks_z_) * brick_volume, value);
+}
+
+template <typename T, typename CoordsType, int BrickSize>
+BrickedVolume<T, CoordsType, BrickSize>::BrickedVolume(const Volume<T, CoordsType>& volume) : BrickedVolume(volume.width(), volume.height(), volume.depth())
+{
+    for (size_type z = 0; z < slices_; ++z)
+        for (size_type y = 0; y < rows_; ++y)
+            for (size_type x = 0; x < cols_; ++x)
+                at(x, y, z) = volume.at(x, y, z);
+}
+
+template <typename T, typename CoordsType, int BrickSize>
+std::size_t BrickedVolume<T, CoordsType, BrickSize>::brick_offset(const size_type brick_col, const size_type brick_row, const size_type brick_slice) const
+{
+    return static_cast<std::size_t>((brick_slice * bricks_y_ + brick_row) * bricks_x_ + brick_col) * brick_volume;
+}
+
+template <typename T, typename CoordsType, int BrickSize>
+std::size_t BrickedVolume<T, CoordsType, BrickSize>::idx(const size_type col, const size_type row, const size_type slice) const
+{
+    assert(col >= 0 && col < cols_);
+    assert(row >= 0 && row < rows_);
+    assert(slice >= 0 && slice < slices_);
+    return brick_offset(col >> shift, row >> shift, slice >> shift) + static_cast<std::size_t>((((slice & mask) << shift | (row & mask)) << shift) | (col & mask));
+}
+
+template <typename T, typename CoordsType, int BrickSize>
+std::span<T, BrickedVolume<T, CoordsType, BrickSize>::brick_volume> BrickedVolume<T, CoordsType, BrickSize>::brick(const size_type brick_col, const size_type brick_row, const size_type brick_slice)
+{
+    assert(brick_col >= 0 && brick_col < bricks_x_);
+    assert(brick_row >= 0 && brick_row < bricks_y_);
+    assert(brick_slice >= 0 && brick_slice < bricks_z_);
+    return std::span<T, brick_volume>{data_.data() + brick_offset(brick_col, brick_row, brick_slice), brick_volume};
+}
+
+template <typename T, typename CoordsType, int BrickSize>
+std::span<const T, BrickedVolume<T, CoordsType, BrickSize>::brick_volume> BrickedVolume<T, CoordsType, BrickSize>::brick(const size_type brick_col, const size_type brick_row, const size_type brick_slice) const
+{
+    assert(brick_col >= 0 && brick_col < bricks_x_);
+    assert(brick_row >= 0 && brick_row < bricks_y_);
+    assert(brick_slice >= 0 && brick_slice < bricks_z_);
+    return std::span<const T, brick_volume>{data_.data() + brick_offset(brick_col, brick_row, brick_slice), brick_volume};
+}
+
+template <typename T, typename CoordsType, int BrickSize>
+Volume<T, CoordsType> BrickedVolume<T, CoordsType, BrickSize>::to_volume() const
+{
+    Volume<T, CoordsType> volume{cols_, rows_, slices_};
+
+    for (size_type z = 0; z < slices_; ++z)
+        for (size_type y = 0; y < rows_; ++y)
+            for (size_type x = 0; x < cols_; ++x)
+                volume.at(x, y, z) = at(x, y, z);
+
+    return volume;
+}
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <algorithm>
 #include <compare>
 #include <limits>
+#include <span>
+#include <tuple>
 
 template <typename CoordinatesType = int>
 struct Coords {
@@ -64,3 +67,12 @@ struct Coords {
 
     auto operator<=>(const Coords& rhs) const = default;
 };
+
+// Sorts coordinates tile by tile (and row by row inside each tile), so that accessing them in this order
+// touches as few cache lines and pages as possible at once.
+template <typename CoordsType>
+void sort_by_tile(std::span<CoordsType> coords, const int tile_size = 64)
+{
+    const auto key = [=](const CoordsType& c) { return std::tuple{c.row() / tile_size, c.col() / tile_size, c.row(), c.col()}; };
+    std::sort(coords.begin(), coords.end(), [&](const CoordsType& a, const CoordsType& b) { return key(a) < key(b); });
+}
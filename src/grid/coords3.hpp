@@ -0,0 +1,63 @@
+#pragma once
+
+#include <compare>
+#include <limits>
+
+template <typename CoordinatesType = int>
+struct Coords3 {
+    using coordinates_type = CoordinatesType;
+
+    static_assert(std::numeric_limits<coordinates_type>::digits <= std::numeric_limits<int>::digits, "maximum supported coordinates type is int32");
+
+    coordinates_type x{};
+    coordinates_type y{};
+    coordinates_type z{};
+
+    Coords3() : x{}, y{}, z{} { }
+    Coords3(coordinates_type x_coord, coordinates_type y_coord, coordinates_type z_coord) : x{x_coord}, y{y_coord}, z{z_coord} { }
+
+    static coordinates_type max() { return std::numeric_limits<coordinates_type>::max(); }
+
+    [[nodiscard]] coordinates_type col() const { return x; }
+    [[nodiscard]] coordinates_type row() const { return y; }
+    [[nodiscard]] coordinates_type slice() const { return z; }
+
+    void move(const int dx, const int dy, const int dz)
+    {
+        x = static_cast<coordinates_type>(x + dx);
+        y = static_cast<coordinates_type>(y + dy);
+        z = static_cast<coordinates_type>(z + dz);
+    }
+
+    void move(const Coords3& delta)
+    {
+        x += delta.x;
+        y += delta.y;
+        z += delta.z;
+    }
+
+    void move_horizontally(const int distance) { x = static_cast<coordinates_type>(x + distance); }
+    void move_vertically(const int distance) { y = static_cast<coordinates_type>(y + distance); }
+    void move_in_depth(const int distance) { z = static_cast<coordinates_type>(z + distance); }
+
+    Coords3 operator+(const Coords3& other) const { return Coords3{static_cast<coordinates_type>(x + other.x), static_cast<coordinates_type>(y + other.y), static_cast<coordinates_type>(z + other.z)}; }
+    Coords3 operator-(const Coords3& other) const { return Coords3{static_cast<coordinates_type>(x - other.x), static_cast<coordinates_type>(y - other.y), static_cast<coordinates_type>(z - other.z)}; }
+
+    Coords3& operator+=(const Coords3& other)
+    {
+        x += other.x;
+        y += other.y;
+        z += other.z;
+        return *this;
+    }
+
+    Coords3& operator-=(const Coords3& other)
+    {
+        x -= other.x;
+        y -= other.y;
+        z -= other.z;
+        return *this;
+    }
+
+    auto operator<=>(const Coords3& rhs) const = default;
+};
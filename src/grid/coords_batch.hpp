@@ -0,0 +1,223 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "coords.hpp"
+
+// Structure-of-arrays container for many coordinates: all x and all y coordinates are stored in separate, cache line
+// aligned arrays, so the bulk operations below are simple loops over contiguous values that the compiler vectorizes.
+template <typename CoordinatesType = int>
+class CoordsBatch {
+public:
+    using coordinates_type = CoordinatesType;
+    using coords_type = Coords<CoordinatesType>;
+    using size_type = std::size_t;
+
+    static constexpr std::size_t alignment = 64;
+
+    CoordsBatch() = default;
+    explicit CoordsBatch(const size_type count) : x_(count), y_(count) { }
+    CoordsBatch(std::initializer_list<coords_type> init) : CoordsBatch(std::span{init.begin(), init.size()}) { }
+    explicit CoordsBatch(std::span<const coords_type> coords);
+
+    size_type size() const { return x_.size(); }
+    bool empty() const { return x_.empty(); }
+
+    void reserve(const size_type count)
+    {
+        x_.reserve(count);
+        y_.reserve(count);
+    }
+
+    void resize(const size_type count)
+    {
+        x_.resize(count);
+        y_.resize(count);
+    }
+
+    void clear()
+    {
+        x_.clear();
+        y_.clear();
+    }
+
+    void push_back(const coords_type& coords)
+    {
+        x_.push_back(coords.x);
+        y_.push_back(coords.y);
+    }
+
+    [[nodiscard]] coords_type operator[](const size_type pos) const { return coords_type{x_[pos], y_[pos]}; }
+
+    void set(const size_type pos, const coords_type& coords)
+    {
+        x_[pos] = coords.x;
+        y_[pos] = coords.y;
+    }
+
+    [[nodiscard]] std::span<coordinates_type> xs() { return x_; }
+    [[nodiscard]] std::span<const coordinates_type> xs() const { return x_; }
+    [[nodiscard]] std::span<coordinates_type> ys() { return y_; }
+    [[nodiscard]] std::span<const coordinates_type> ys() const { return y_; }
+
+    void translate(int dx, int dy);
+    void translate(const CoordsBatch& deltas);
+    void clamp(const coords_type& min, const coords_type& max);
+
+    size_type in_bounds(int width, int height, std::span<bool> result) const;
+
+    void manhattan_distances(const coords_type& target, std::span<int> result) const;
+    void chebyshev_distances(const coords_type& target, std::span<int> result) const;
+    void squared_euclidean_distances(const coords_type& target, std::span<int> result) const;
+    void euclidean_distances(const coords_type& target, std::span<float> result) const;
+
+    void to_indices(int width, std::span<int> result) const;
+
+private:
+    std::vector<coordinates_type, AlignedAllocator<coordinates_type, alignment>> x_;
+    std::vector<coordinates_type, AlignedAllocator<coordinates_type, alignment>> y_;
+};
+
+template <typename CoordinatesType>
+CoordsBatch<CoordinatesType>::CoordsBatch(const std::span<const coords_type> coords) : x_(coords.size()), y_(coords.size())
+{
+    for (size_type i = 0; i < coords.size(); ++i) {
+        x_[i] = coords[i].x;
+        y_[i] = coords[i].y;
+    }
+}
+
+template <typename CoordinatesType>
+void CoordsBatch<CoordinatesType>::translate(const int dx, const int dy)
+{
+    coordinates_type* x = x_.data();
+    coordinates_type* y = y_.data();
+
+    for (size_type i = 0; i < size(); ++i) {
+        x[i] = static_cast<coordinates_type>(x[i] + dx);
+        y[i] = static_cast<coordinates_type>(y[i] + dy);
+    }
+}
+
+template <typename CoordinatesType>
+void CoordsBatch<CoordinatesType>::translate(const CoordsBatch& deltas)
+{
+    assert(deltas.size() == size());
+
+    coordinates_type* x = x_.data();
+    coordinates_type* y = y_.data();
+    const coordinates_type* dx = deltas.x_.data();
+    const coordinates_type* dy = deltas.y_.data();
+
+    for (size_type i = 0; i < size(); ++i) {
+        x[i] = static_cast<coordinates_type>(x[i] + dx[i]);
+        y[i] = static_cast<coordinates_type>(y[i] + dy[i]);
+    }
+}
+
+template <typename CoordinatesType>
+void CoordsBatch<CoordinatesType>::clamp(const coords_type& min, const coords_type& max)
+{
+    assert(min.x <= max.x && min.y <= max.y);
+
+    coordinates_type* x = x_.data();
+    coordinates_type* y = y_.data();
+
+    for (size_type i = 0; i < size(); ++i) {
+        x[i] = std::min(std::max(x[i], min.x), max.x);
+        y[i] = std::min(std::max(y[i], min.y), max.y);
+    }
+}
+
+// Sets result[i] to whether coordinates i are inside of a Grid of the given size, returns the number of coordinates inside.
+template <typename CoordinatesType>
+typename CoordsBatch<CoordinatesType>::size_type CoordsBatch<CoordinatesType>::in_bounds(const int width, const int height, const std::span<bool> result) const
+{
+    assert(result.size() >= size());
+
+    const coordinates_type* x = x_.data();
+    const coordinates_type* y = y_.data();
+    size_type count = 0;
+
+    for (size_type i = 0; i < size(); ++i) {
+        const bool inside = (static_cast<unsigned>(x[i]) < static_cast<unsigned>(width)) & (static_cast<unsigned>(y[i]) < static_cast<unsigned>(height));
+        result[i] = inside;
+        count += inside;
+    }
+
+    return count;
+}
+
+template <typename CoordinatesType>
+void CoordsBatch<CoordinatesType>::manhattan_distances(const coords_type& target, const std::span<int> result) const
+{
+    assert(result.size() >= size());
+
+    const coordinates_type* x = x_.data();
+    const coordinates_type* y = y_.data();
+
+    for (size_type i = 0; i < size(); ++i)
+        result[i] = std::abs(x[i] - target.x) + std::abs(y[i] - target.y);
+}
+
+template <typename CoordinatesType>
+void CoordsBatch<CoordinatesType>::chebyshev_distances(const coords_type& target, const std::span<int> result) const
+{
+    assert(result.size() >= size());
+
+    const coordinates_type* x = x_.data();
+    const coordinates_type* y = y_.data();
+
+    for (size_type i = 0; i < size(); ++i)
+        result[i] = std::max(std::abs(x[i] - target.x), std::abs(y[i] - target.y));
+}
+
+template <typename CoordinatesType>
+void CoordsBatch<CoordinatesType>::squared_euclidean_distances(const coords_type& target, const std::span<int> result) const
+{
+    assert(result.size() >= size());
+
+    const coordinates_type* x = x_.data();
+    const coordinates_type* y = y_.data();
+
+    for (size_type i = 0; i < size(); ++i) {
+        const int dx = x[i] - target.x;
+        const int dy = y[i] - target.y;
+        result[i] = dx * dx + dy * dy;
+    }
+}
+
+// Prefer squared_euclidean_distances() for comparisons: unless compiled with -fno-math-errno, std::sqrt keeps this loop scalar.
+template <typename CoordinatesType>
+void CoordsBatch<CoordinatesType>::euclidean_distances(const coords_type& target, const std::span<float> result) const
+{
+    assert(result.size() >= size());
+
+    const coordinates_type* x = x_.data();
+    const coordinates_type* y = y_.data();
+
+    for (size_type i = 0; i < size(); ++i) {
+        const auto dx = static_cast<float>(x[i] - target.x);
+        const auto dy = static_cast<float>(y[i] - target.y);
+        result[i] = std::sqrt(dx * dx + dy * dy);
+    }
+}
+
+// Linear indices into a Grid of the given width, like Grid::at() would calculate them.
+template <typename CoordinatesType>
+void CoordsBatch<CoordinatesType>::to_indices(const int width, const std::span<int> result) const
+{
+    assert(result.size() >= size());
+
+    const coordinates_type* x = x_.data();
+    const coordinates_type* y = y_.data();
+
+    for (size_type i = 0; i < size(); ++i)
+        result[i] = y[i] * width + x[i];
+}
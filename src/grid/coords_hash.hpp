@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#include "coords.hpp"
+
+// murmur3 64 bit finalizer: every input bit affects every output bit, so the low bits of the result (used by hash
+// tables to select a bucket) depend on both coordinates, even though they are packed into separate halves.
+[[nodiscard]] constexpr std::uint64_t mix_coords_hash(std::uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+template <typename CoordinatesType>
+struct std::hash<Coords<CoordinatesType>> {
+    std::size_t operator()(const Coords<CoordinatesType>& coords) const noexcept
+    {
+        using unsigned_type = std::make_unsigned_t<CoordinatesType>;
+        return mix_coords_hash((std::uint64_t{static_cast<unsigned_type>(coords.x)} << 32) | std::uint64_t{static_cast<unsigned_type>(coords.y)});
+    }
+};
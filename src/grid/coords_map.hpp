@@ -0,0 +1,491 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "aligned_allocator.hpp"
+#include "coords_hash.hpp"
+
+// Flat open-addressing hash table for coordinate keys (Swiss table layout): all entries live in one array next to an
+// array of control bytes, one per slot, holding 7 bits of the hash of a full slot or marking it as empty or deleted.
+// Lookups probe groups of 16 control bytes at once (with SSE2 a single compare), so only slots with matching hash
+// bits get their keys compared. No allocation per entry, the arrays grow by doubling when 7/8 full.
+// Use through the CoordsMap and CoordsSet aliases, Mapped = void makes it a set.
+template <typename CoordsType, typename Mapped, typename Hash = std::hash<CoordsType>>
+class CoordsHashTable {
+    static constexpr bool is_set = std::is_void_v<Mapped>;
+
+public:
+    using key_type = CoordsType;
+    using mapped_type = Mapped;
+    using value_type = std::conditional_t<is_set, CoordsType, std::pair<const CoordsType, Mapped>>;
+    using size_type = std::size_t;
+    using hasher = Hash;
+
+    static constexpr size_type group_size = 16;
+
+private:
+    using ctrl_type = std::int8_t;
+
+    static constexpr ctrl_type ctrl_empty = -128;
+    static constexpr ctrl_type ctrl_deleted = -2;
+
+    // 16 control bytes, every match returns a bit mask with bit i set for slot i
+    class Group {
+    public:
+        explicit Group(const ctrl_type* ctrl)
+        {
+#if defined(__SSE2__)
+            ctrl_ = _mm_load_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+            std::memcpy(ctrl_, ctrl, group_size);
+#endif
+        }
+
+        [[nodiscard]] unsigned match(const ctrl_type h2) const
+        {
+#if defined(__SSE2__)
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(h2))));
+#else
+            unsigned mask = 0;
+
+            for (size_type i = 0; i < group_size; ++i)
+                mask |= static_cast<unsigned>(ctrl_[i] == h2) << i;
+
+            return mask;
+#endif
+        }
+
+        [[nodiscard]] unsigned match_empty() const { return match(ctrl_empty); }
+
+        // empty and deleted are the only negative control bytes
+        [[nodiscard]] unsigned match_empty_or_deleted() const
+        {
+#if defined(__SSE2__)
+            return static_cast<unsigned>(_mm_movemask_epi8(ctrl_));
+#else
+            unsigned mask = 0;
+
+            for (size_type i = 0; i < group_size; ++i)
+                mask |= static_cast<unsigned>(ctrl_[i] < 0) << i;
+
+            return mask;
+#endif
+        }
+
+    private:
+#if defined(__SSE2__)
+        __m128i ctrl_;
+#else
+        ctrl_type ctrl_[group_size];
+#endif
+    };
+
+    template <bool IsConst>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = CoordsHashTable::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst || is_set, const value_type*, value_type*>;
+        using reference = std::conditional_t<IsConst || is_set, const value_type&, value_type&>;
+
+        Iterator() : table_{}, pos_{} { }
+        Iterator(const CoordsHashTable* table, const size_type pos) : table_{table}, pos_{pos} { skip_free_slots(); }
+
+        template <bool OtherIsConst>
+        requires(IsConst && !OtherIsConst)
+        Iterator(const Iterator<OtherIsConst>& other) : table_{other.table_}, pos_{other.pos_} { }
+
+        reference operator*() const { return table_->slots_[pos_]; }
+        pointer operator->() const { return &**this; }
+
+        Iterator& operator++()
+        {
+            ++pos_;
+            skip_free_slots();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            const Iterator tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator& rhs) const { return pos_ == rhs.pos_; }
+
+    private:
+        friend class CoordsHashTable;
+
+        template <bool>
+        friend class Iterator;
+
+        const CoordsHashTable* table_;
+        size_type pos_;
+
+        void skip_free_slots()
+        {
+            while (pos_ < table_->capacity_ && table_->ctrl_[pos_] < 0)
+                ++pos_;
+        }
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    CoordsHashTable() = default;
+    explicit CoordsHashTable(const size_type count) { reserve(count); }
+    CoordsHashTable(std::initializer_list<value_type> init);
+
+    CoordsHashTable(const CoordsHashTable& other);
+    CoordsHashTable(CoordsHashTable&& other) noexcept { swap(other); }
+
+    CoordsHashTable& operator=(CoordsHashTable other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    ~CoordsHashTable() { destroy(); }
+
+    void swap(CoordsHashTable& other) noexcept
+    {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(deleted_, other.deleted_);
+    }
+
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_type capacity() const { return capacity_; }
+
+    iterator begin() { return iterator{this, 0}; }
+    iterator end() { return iterator{this, capacity_}; }
+    const_iterator begin() const { return const_iterator{this, 0}; }
+    const_iterator end() const { return const_iterator{this, capacity_}; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    [[nodiscard]] iterator find(const key_type& key) { return iterator{this, find_index(key, hasher{}(key))}; }
+    [[nodiscard]] const_iterator find(const key_type& key) const { return const_iterator{this, find_index(key, hasher{}(key))}; }
+
+    [[nodiscard]] bool contains(const key_type& key) const { return find_index(key, hasher{}(key)) != capacity_; }
+    [[nodiscard]] size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args);
+
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        if constexpr (is_set)
+            return try_emplace(value);
+        else
+            return try_emplace(value.first, value.second);
+    }
+
+    template <typename M>
+    requires(!is_set)
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+    {
+        if (const iterator it = find(key); it != end()) {
+            it->second = std::forward<M>(obj);
+            return {it, false};
+        }
+
+        return try_emplace(key, std::forward<M>(obj));
+    }
+
+    auto& operator[](const key_type& key) requires(!is_set) { return try_emplace(key).first->second; }
+
+    auto& at(const key_type& key) requires(!is_set)
+    {
+        const size_type pos = find_index(key, hasher{}(key));
+
+        if (pos == capacity_)
+            throw std::out_of_range{"CoordsHashTable::at"};
+
+        return slots_[pos].second;
+    }
+
+    const auto& at(const key_type& key) const requires(!is_set) { return const_cast<CoordsHashTable&>(*this).at(key); }
+
+    size_type erase(const key_type& key);
+    iterator erase(const_iterator pos);
+
+    void clear();
+    void reserve(size_type count);
+
+private:
+    ctrl_type* ctrl_ = nullptr;
+    value_type* slots_ = nullptr;
+    size_type capacity_ = 0;
+    size_type size_ = 0;
+    size_type deleted_ = 0;
+
+    using ctrl_allocator = AlignedAllocator<ctrl_type, group_size>;
+    using slot_allocator = std::allocator<value_type>;
+
+    static const key_type& key_of(const value_type& slot)
+    {
+        if constexpr (is_set)
+            return slot;
+        else
+            return slot.first;
+    }
+
+    // the low 7 bits of the hash go into the control bytes, the rest selects the first group to probe
+    static ctrl_type h2(const std::size_t hash) { return static_cast<ctrl_type>(hash & 0x7f); }
+    static size_type h1(const std::size_t hash) { return hash >> 7; }
+
+    size_type group_mask() const { return capacity_ / group_size - 1; }
+    size_type max_load() const { return capacity_ - capacity_ / 8; }
+
+    [[nodiscard]] size_type find_index(const key_type& key, std::size_t hash) const;
+    [[nodiscard]] size_type find_insert_index(std::size_t hash) const;
+
+    void erase_index(size_type pos);
+    void rehash(size_type new_capacity);
+    void destroy();
+};
+
+template <typename CoordsType, typename T, typename Hash = std::hash<CoordsType>>
+using CoordsMap = CoordsHashTable<CoordsType, T, Hash>;
+
+template <typename CoordsType, typename Hash = std::hash<CoordsType>>
+using CoordsSet = CoordsHashTable<CoordsType, void, Hash>;
+
+template <typename CoordsType, typename Mapped, typename Hash>
+CoordsHashTable<CoordsType, Mapped, Hash>::CoordsHashTable(std::initializer_list<value_type> init)
+{
+    reserve(init.size());
+
+    for (const auto& value : init)
+        insert(value);
+}
+
+template <typename CoordsType, typename Mapped, typename Hash>
+CoordsHashTable<CoordsType, Mapped, Hash>::CoordsHashTable(const CoordsHashTable& other)
+{
+    if (other.capacity_ == 0)
+        return;
+
+    ctrl_ = ctrl_allocator{}.allocate(other.capacity_);
+    slots_ = slot_allocator{}.allocate(other.capacity_);
+    capacity_ = other.capacity_;
+    std::copy_n(other.ctrl_, capacity_, ctrl_);
+
+    for (size_type i = 0; i < capacity_; ++i)
+        if (ctrl_[i] >= 0)
+            std::construct_at(slots_ + i, other.slots_[i]);
+
+    size_ = other.size_;
+    deleted_ = other.deleted_;
+}
+
+// Probes group after group (with growing distance, which visits every group once as the number of groups is a power
+// of two) and stops at the first group with an empty slot: the key would have been inserted there or earlier.
+// Returns capacity() if the key was not found.
+template <typename CoordsType, typename Mapped, typename Hash>
+typename CoordsHashTable<CoordsType, Mapped, Hash>::size_type CoordsHashTable<CoordsType, Mapped, Hash>::find_index(const key_type& key, const std::size_t hash) const
+{
+    if (capacity_ == 0)
+        return capacity_;
+
+    size_type group = h1(hash) & group_mask();
+
+    for (size_type probe = 1; probe <= capacity_ / group_size; ++probe) {
+        const Group g{ctrl_ + group * group_size};
+
+        for (unsigned match = g.match(h2(hash)); match != 0; match &= match - 1) {
+            const size_type pos = group * group_size + static_cast<size_type>(std::countr_zero(match));
+
+            if (key_of(slots_[pos]) == key)
+                return pos;
+        }
+
+        if (g.match_empty() != 0)
+            break;
+
+        group = (group + probe) & group_mask();
+    }
+
+    return capacity_;
+}
+
+template <typename CoordsType, typename Mapped, typename Hash>
+typename CoordsHashTable<CoordsType, Mapped, Hash>::size_type CoordsHashTable<CoordsType, Mapped, Hash>::find_insert_index(const std::size_t hash) const
+{
+    size_type group = h1(hash) & group_mask();
+
+    for (size_type probe = 1;; ++probe) {
+        const unsigned free = Group{ctrl_ + group * group_size}.match_empty_or_deleted();
+
+        if (free != 0)
+            return group * group_size + static_cast<size_type>(std::countr_zero(free));
+
+        group = (group + probe) & group_mask();
+    }
+}
+
+template <typename CoordsType, typename Mapped, typename Hash>
+template <typename... Args>
+std::pair<typename CoordsHashTable<CoordsType, Mapped, Hash>::iterator, bool> CoordsHashTable<CoordsType, Mapped, Hash>::try_emplace(const key_type& key, Args&&... args)
+{
+    const std::size_t hash = hasher{}(key);
+
+    if (const size_type pos = find_index(key, hash); pos != capacity_)
+        return {iterator{this, pos}, false};
+
+    // grow if there are mostly entries, otherwise rehashing at the same size is enough to drop the tombstones
+    if (size_ + deleted_ + 1 > max_load())
+        rehash(capacity_ == 0 ? group_size : (size_ + 1 > max_load() / 2 ? 2 * capacity_ : capacity_));
+
+    const size_type pos = find_insert_index(hash);
+
+    if (ctrl_[pos] == ctrl_deleted)
+        --deleted_;
+
+    if constexpr (is_set)
+        std::construct_at(slots_ + pos, key);
+    else
+        std::construct_at(slots_ + pos, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+
+    ctrl_[pos] = h2(hash);
+    ++size_;
+
+    return {iterator{this, pos}, true};
+}
+
+template <typename CoordsType, typename Mapped, typename Hash>
+typename CoordsHashTable<CoordsType, Mapped, Hash>::size_type CoordsHashTable<CoordsType, Mapped, Hash>::erase(const key_type& key)
+{
+    const size_type pos = find_index(key, hasher{}(key));
+
+    if (pos == capacity_)
+        return 0;
+
+    erase_index(pos);
+    return 1;
+}
+
+template <typename CoordsType, typename Mapped, typename Hash>
+typename CoordsHashTable<CoordsType, Mapped, Hash>::iterator CoordsHashTable<CoordsType, Mapped, Hash>::erase(const const_iterator pos)
+{
+    assert(pos.pos_ < capacity_ && ctrl_[pos.pos_] >= 0);
+    erase_index(pos.pos_);
+    return iterator{this, pos.pos_ + 1};
+}
+
+// A slot can become empty again if its group still has an empty slot: every lookup reaching this group stops here
+// anyway. Otherwise lookups must continue past it to later groups, so it becomes a tombstone.
+template <typename CoordsType, typename Mapped, typename Hash>
+void CoordsHashTable<CoordsType, Mapped, Hash>::erase_index(const size_type pos)
+{
+    std::destroy_at(slots_ + pos);
+
+    if (Group{ctrl_ + pos / group_size * group_size}.match_empty() != 0) {
+        ctrl_[pos] = ctrl_empty;
+    } else {
+        ctrl_[pos] = ctrl_deleted;
+        ++deleted_;
+    }
+
+    --size_;
+}
+
+template <typename CoordsType, typename Mapped, typename Hash>
+void CoordsHashTable<CoordsType, Mapped, Hash>::clear()
+{
+    for (size_type i = 0; i < capacity_; ++i)
+        if (ctrl_[i] >= 0)
+            std::destroy_at(slots_ + i);
+
+    std::fill_n(ctrl_, capacity_, ctrl_empty);
+    size_ = 0;
+    deleted_ = 0;
+}
+
+template <typename CoordsType, typename Mapped, typename Hash>
+void CoordsHashTable<CoordsType, Mapped, Hash>::reserve(const size_type count)
+{
+    const size_type required = std::bit_ceil(std::max(group_size, count + count / 7 + 1));
+
+    if (required > capacity_)
+        rehash(required);
+}
+
+template <typename CoordsType, typename Mapped, typename Hash>
+void CoordsHashTable<CoordsType, Mapped, Hash>::rehash(const size_type new_capacity)
+{
+    assert(new_capacity >= group_size && std::has_single_bit(new_capacity));
+
+    // Fills a separate table and swaps it in at the end, so if an allocation throws this table is unchanged.
+    // Entries are moved with std::move_if_noexcept, a throwing copy leaves them unchanged as well, only a throwing
+    // move of a type that cannot be copied leaves some of them moved-from.
+    ctrl_type* new_ctrl = ctrl_allocator{}.allocate(new_capacity);
+    value_type* new_slots = nullptr;
+
+    try {
+        new_slots = slot_allocator{}.allocate(new_capacity);
+    } catch (...) {
+        ctrl_allocator{}.deallocate(new_ctrl, new_capacity);
+        throw;
+    }
+
+    std::fill_n(new_ctrl, new_capacity, ctrl_empty);
+
+    // from here on the destructor of rehashed frees the arrays and the entries moved so far
+    CoordsHashTable rehashed;
+    rehashed.ctrl_ = new_ctrl;
+    rehashed.slots_ = new_slots;
+    rehashed.capacity_ = new_capacity;
+
+    for (size_type i = 0; i < capacity_; ++i) {
+        if (ctrl_[i] < 0)
+            continue;
+
+        const std::size_t hash = hasher{}(key_of(slots_[i]));
+        const size_type pos = rehashed.find_insert_index(hash);
+
+        std::construct_at(rehashed.slots_ + pos, std::move_if_noexcept(slots_[i]));
+        rehashed.ctrl_[pos] = h2(hash);
+        ++rehashed.size_;
+    }
+
+    swap(rehashed);
+}
+
+template <typename CoordsType, typename Mapped, typename Hash>
+void CoordsHashTable<CoordsType, Mapped, Hash>::destroy()
+{
+    if (capacity_ == 0)
+        return;
+
+    clear();
+    ctrl_allocator{}.deallocate(ctrl_, capacity_);
+    slot_allocator{}.deallocate(slots_, capacity_);
+    ctrl_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = 0;
+}
@@ -1,13 +1,33 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
 #include <compare>
+#include <cstdint>
 #include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
 #include <vector>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(GRID_ACCESS_TRACING)
+#include "access_trace.hpp"
+#endif
+
 #include "gridcell.hpp"
+#include "gridcursor.hpp"
+#include "strided_iterator.hpp"
 
-template <typename T = int, typename CoordsType = Coords<int>>
+// The values are stored in a std::vector using Allocator, so a Grid can for example live in a per-frame
+// std::pmr::monotonic_buffer_resource (see PmrGrid) or in memory from a custom pool.
+template <typename T = int, typename CoordsType = Coords<int>, typename Allocator = std::allocator<T>>
 class Grid {
 public:
     using difference_type = std::ptrdiff_t;
@@ -18,80 +38,7 @@ public:
 
 private:
     template <typename pointer, typename reference>
-    class ValueIterator {
-    public:
-        using iterator_category = std::random_access_iterator_tag;
-        using value_type = T;
-        using difference_type = Grid::difference_type;
-
-        ValueIterator() : ptr_{}, stride_{} { }
-        ValueIterator(pointer ptr, const difference_type stride)
-        {
-            assert(ptr != nullptr);
-            assert(stride > 0);
-            ptr_ = ptr;
-            stride_ = stride;
-        }
-
-        reference operator*() const { return *ptr_; }
-        pointer operator->() const { return ptr_; }
-
-        ValueIterator& operator++()
-        {
-            ptr_ += stride_;
-            return *this;
-        }
-
-        ValueIterator operator++(int)
-        {
-            const ValueIterator tmp{*this};
-            ++(*this);
-            return tmp;
-        }
-
-        ValueIterator& operator--()
-        {
-            ptr_ -= stride_;
-            return *this;
-        }
-
-        ValueIterator operator--(int)
-        {
-            const ValueIterator tmp{*this};
-            --(*this);
-            return tmp;
-        }
-
-        ValueIterator& operator+=(const difference_type off)
-        {
-            ptr_ += off * stride_;
-            return *this;
-        }
-
-        ValueIterator& operator-=(const difference_type off)
-        {
-            ptr_ -= off * stride_;
-            return *this;
-        }
-
-        ValueIterator operator+(const difference_type off) const { return ValueIterator{ptr_ + off * stride_, stride_}; }
-        ValueIterator operator-(const difference_type off) const { return ValueIterator{ptr_ - off * stride_, stride_}; }
-        friend ValueIterator operator+(const difference_type off, const ValueIterator& a) { return ValueIterator{a.ptr_ + off * a.stride_, a.stride_}; }
-        friend difference_type operator-(const ValueIterator& a, const ValueIterator& b)
-        {
-            assert(a.stride_ == b.stride_);
-            return (a.ptr_ - b.ptr_) / a.stride_;
-        };
-
-        reference operator[](const difference_type off) const { return *(ptr_ + off * stride_); }
-
-        auto operator<=>(const ValueIterator& rhs) const { return ptr_ <=> rhs.ptr_; }
-        bool operator==(const ValueIterator& rhs) const { return ptr_ == rhs.ptr_; }
-
-    private:
-        pointer ptr_;
-        difference_type stride_;
-    };
+    using ValueIterator = StridedIterator<pointer, reference>;
 
     template <typename pointer, typename reference>
     class RowOrCol {
@@ -324,15 +271,20 @@ public:
     using const_pointer = const T*;
     using const_reference = const T&;
     using coords_type = CoordsType;
+    using allocator_type = Allocator;
     using grid_rows_type = GridRowsOrCols<pointer, reference>;
     using grid_cols_type = GridRowsOrCols<pointer, reference>;
     using const_grid_rows_type = GridRowsOrCols<const_pointer, const_reference>;
     using const_grid_cols_type = GridRowsOrCols<const_pointer, const_reference>;
-    using grid_cell_type = GridCell<Grid<T, coords_type>*, coords_type>;
-    using const_grid_cell_type = GridCell<const Grid<T, coords_type>*, coords_type>;
+    using grid_cell_type = GridCell<Grid*, coords_type>;
+    using const_grid_cell_type = GridCell<const Grid*, coords_type>;
+    using grid_cursor_type = GridCursor<Grid*, coords_type>;
+    using const_grid_cursor_type = GridCursor<const Grid*, coords_type>;
 
-    Grid(size_type cols, size_type rows);
-    Grid(size_type cols, size_type rows, const T& value);
+    Grid(size_type cols, size_type rows, const Allocator& alloc = Allocator{});
+    Grid(size_type cols, size_type rows, const T& value, const Allocator& alloc = Allocator{});
+
+    allocator_type get_allocator() const { return data_.get_allocator(); }
 
     size_type width() const { return cols_; }
     size_type height() const { return rows_; }
@@ -342,11 +294,11 @@ public:
     pointer data() { return data_.data(); }
     const_pointer data() const { return data_.data(); }
 
-    [[nodiscard]] reference at(size_type col, size_type row) { return data_[idx(col, row)]; }
-    [[nodiscard]] const_reference at(size_type col, size_type row) const { return data_[idx(col, row)]; }
+    [[nodiscard]] reference at(size_type col, size_type row) { return value_at(idx(col, row)); }
+    [[nodiscard]] const_reference at(size_type col, size_type row) const { return value_at(idx(col, row)); }
 
-    [[nodiscard]] reference at(const coords_type& coords) { return data_[idx(coords)]; }
-    [[nodiscard]] const_reference at(const coords_type& coords) const { return data_[idx(coords)]; }
+    [[nodiscard]] reference at(const coords_type& coords) { return value_at(idx(coords)); }
+    [[nodiscard]] const_reference at(const coords_type& coords) const { return value_at(idx(coords)); }
 
     [[nodiscard]] grid_cell_type cell(const coords_type& coords) { return grid_cell_type{this, coords}; }
     [[nodiscard]] const_grid_cell_type cell(const coords_type& coords) const { return const_grid_cell_type{this, coords}; }
@@ -354,6 +306,12 @@ public:
     [[nodiscard]] grid_cell_type cell(size_type col, size_type row) { return cell(coords_type{static_cast<typename coords_type::coordinates_type>(col), static_cast<typename coords_type::coordinates_type>(row)}); }
     [[nodiscard]] const_grid_cell_type cell(size_type col, size_type row) const { return cell(coords_type{static_cast<typename coords_type::coordinates_type>(col), static_cast<typename coords_type::coordinates_type>(row)}); }
 
+    [[nodiscard]] grid_cursor_type cursor(const coords_type& coords) { return grid_cursor_type{this, coords}; }
+    [[nodiscard]] const_grid_cursor_type cursor(const coords_type& coords) const { return const_grid_cursor_type{this, coords}; }
+
+    [[nodiscard]] grid_cursor_type cursor(size_type col, size_type row) { return cursor(coords_type{static_cast<typename coords_type::coordinates_type>(col), static_cast<typename coords_type::coordinates_type>(row)}); }
+    [[nodiscard]] const_grid_cursor_type cursor(size_type col, size_type row) const { return cursor(coords_type{static_cast<typename coords_type::coordinates_type>(col), static_cast<typename coords_type::coordinates_type>(row)}); }
+
     auto begin() { return data_.begin(); }
     auto begin() const { return data_.cbegin(); }
     auto cbegin() const { return data_.cbegin(); }
@@ -383,50 +341,228 @@ public:
     auto operator[](const size_type pos) { return row(pos); }
     auto operator[](const size_type pos) const { return row(pos); }
 
+    std::size_t gather(std::span<const coords_type> coords, std::span<T> values, std::span<bool> in_bounds = {}) const;
+    std::size_t scatter(std::span<const coords_type> coords, std::span<const T> values, std::span<bool> in_bounds = {});
+
 private:
+    static constexpr std::size_t batch_size = 8;
+
     size_type cols_;
     size_type rows_;
 
-    std::vector<T> data_;
+    std::vector<T, Allocator> data_;
 
     [[nodiscard]] inline std::size_t idx(size_type col, size_type row) const;
     [[nodiscard]] inline std::size_t idx(const coords_type& coords) const;
+
+    [[nodiscard]] inline reference value_at(std::size_t index);
+    [[nodiscard]] inline const_reference value_at(std::size_t index) const;
+
+    inline unsigned batch_indices(const coords_type* coords, std::size_t count, std::array<int, batch_size>& indices) const;
+
+#if defined(__AVX2__)
+    // the vectorized index calculation needs tightly packed 32 bit (x, y) pairs
+    static constexpr bool use_avx2 = std::is_same_v<coords_type, Coords<std::int32_t>>;
+    static constexpr bool use_avx2_gather = use_avx2 && sizeof(T) == 4 && std::is_trivially_copyable_v<T>;
+
+    inline __m256i batch_indices_avx2(const coords_type* coords, __m256i& mask) const;
+#endif
 };
 
-template <typename T, typename CoordsType>
-Grid<T, CoordsType>::Grid(const size_type cols, const size_type rows)
+template <typename T, typename CoordsType, typename Allocator>
+Grid<T, CoordsType, Allocator>::Grid(const size_type cols, const size_type rows, const Allocator& alloc) : data_(alloc)
 {
     assert(cols > 0 && rows > 0);
     assert(cols - 1 <= coords_type::max());
     assert(rows - 1 <= coords_type::max());
     cols_ = cols;
     rows_ = rows;
-    data_ = std::vector<T>(static_cast<std::size_t>(cols * rows));
+    data_.resize(static_cast<std::size_t>(cols * rows));
 }
 
-template <typename T, typename CoordsType>
-Grid<T, CoordsType>::Grid(const size_type cols, const size_type rows, const T& value)
+template <typename T, typename CoordsType, typename Allocator>
+Grid<T, CoordsType, Allocator>::Grid(const size_type cols, const size_type rows, const T& value, const Allocator& alloc) : data_(alloc)
 {
     assert(cols > 0 && rows > 0);
     assert(cols - 1 <= coords_type::max());
     assert(rows - 1 <= coords_type::max());
     cols_ = cols;
     rows_ = rows;
-    data_ = std::vector<T>(static_cast<std::size_t>(cols * rows), value);
+    data_.assign(static_cast<std::size_t>(cols * rows), value);
 }
 
-template <typename T, typename CoordsType>
-std::size_t Grid<T, CoordsType>::idx(const size_type col, const size_type row) const
+template <typename T, typename CoordsType, typename Allocator>
+std::size_t Grid<T, CoordsType, Allocator>::idx(const size_type col, const size_type row) const
 {
     assert(col >= 0 && col < cols_);
     assert(row >= 0 && row < rows_);
     return static_cast<std::size_t>(row * cols_ + col);
 }
 
-template <typename T, typename CoordsType>
-std::size_t Grid<T, CoordsType>::idx(const coords_type& coords) const
+template <typename T, typename CoordsType, typename Allocator>
+std::size_t Grid<T, CoordsType, Allocator>::idx(const coords_type& coords) const
+{
+    assert(coords.col() >= 0 && coords.col() < cols_);
+    assert(coords.row() >= 0 && coords.row() < rows_);
+    return static_cast<std::size_t>(coords.row() * cols_ + coords.col());
+}
+
+// at() goes through here, so builds with GRID_ACCESS_TRACING can record the access
+template <typename T, typename CoordsType, typename Allocator>
+typename Grid<T, CoordsType, Allocator>::reference Grid<T, CoordsType, Allocator>::value_at(const std::size_t index)
+{
+#if defined(GRID_ACCESS_TRACING)
+    trace_access(&data_[index]);
+#endif
+    return data_[index];
+}
+
+template <typename T, typename CoordsType, typename Allocator>
+typename Grid<T, CoordsType, Allocator>::const_reference Grid<T, CoordsType, Allocator>::value_at(const std::size_t index) const
 {
-    assert(coords.x >= 0 && coords.x < cols_);
-    assert(coords.y >= 0 && coords.y < rows_);
-    return static_cast<std::size_t>(coords.y * cols_ + coords.x);
+#if defined(GRID_ACCESS_TRACING)
+    trace_access(&data_[index]);
+#endif
+    return data_[index];
 }
+
+// Reads the values at all given coordinates into values[i]. Coordinates outside of the Grid do not assert but are
+// skipped (values[i] stays unchanged) and reported in the optional in_bounds mask. Returns the number of skipped coordinates.
+// Indices are calculated in batches of 8, with AVX2 (if enabled at compile time) also the loads use hardware gathers.
+template <typename T, typename CoordsType, typename Allocator>
+std::size_t Grid<T, CoordsType, Allocator>::gather(const std::span<const coords_type> coords, const std::span<T> values, const std::span<bool> in_bounds) const
+{
+    assert(values.size() >= coords.size());
+    assert(in_bounds.empty() || in_bounds.size() >= coords.size());
+
+    std::size_t out_of_bounds = 0;
+    std::size_t i = 0;
+
+#if defined(__AVX2__)
+    if constexpr (use_avx2_gather) {
+        for (; i + batch_size <= coords.size(); i += batch_size) {
+            __m256i mask;
+            const __m256i indices = batch_indices_avx2(&coords[i], mask);
+            auto* dst = reinterpret_cast<__m256i*>(&values[i]);
+            _mm256_storeu_si256(dst, _mm256_mask_i32gather_epi32(_mm256_loadu_si256(dst), reinterpret_cast<const int*>(data_.data()), indices, mask, 4));
+
+            const auto valid = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+            out_of_bounds += batch_size - static_cast<std::size_t>(std::popcount(valid));
+
+            if (!in_bounds.empty())
+                for (std::size_t j = 0; j < batch_size; ++j)
+                    in_bounds[i + j] = (valid >> j) & 1;
+        }
+    }
+#endif
+
+    std::array<int, batch_size> indices;
+
+    for (; i < coords.size(); i += batch_size) {
+        const std::size_t count = std::min(batch_size, coords.size() - i);
+        const unsigned valid = batch_indices(&coords[i], count, indices);
+
+        for (std::size_t j = 0; j < count; ++j) {
+            const bool is_valid = (valid >> j) & 1;
+
+            if (is_valid)
+                values[i + j] = data_[static_cast<std::size_t>(indices[j])];
+            else
+                ++out_of_bounds;
+
+            if (!in_bounds.empty())
+                in_bounds[i + j] = is_valid;
+        }
+    }
+
+    return out_of_bounds;
+}
+
+// Writes values[i] to all given coordinates. Coordinates outside of the Grid are skipped and reported like in gather().
+// If the same coordinates appear multiple times the last value wins.
+template <typename T, typename CoordsType, typename Allocator>
+std::size_t Grid<T, CoordsType, Allocator>::scatter(const std::span<const coords_type> coords, const std::span<const T> values, const std::span<bool> in_bounds)
+{
+    assert(values.size() >= coords.size());
+    assert(in_bounds.empty() || in_bounds.size() >= coords.size());
+
+    std::size_t out_of_bounds = 0;
+    std::array<int, batch_size> indices;
+
+    for (std::size_t i = 0; i < coords.size(); i += batch_size) {
+        const std::size_t count = std::min(batch_size, coords.size() - i);
+        const unsigned valid = batch_indices(&coords[i], count, indices);
+
+        for (std::size_t j = 0; j < count; ++j) {
+            const bool is_valid = (valid >> j) & 1;
+
+            if (is_valid)
+                data_[static_cast<std::size_t>(indices[j])] = values[i + j];
+            else
+                ++out_of_bounds;
+
+            if (!in_bounds.empty())
+                in_bounds[i + j] = is_valid;
+        }
+    }
+
+    return out_of_bounds;
+}
+
+// Calculates the linear indices of up to batch_size coordinates, returns a bit mask of the coordinates inside of the Grid.
+// Indices of coordinates outside of the Grid are set to 0.
+template <typename T, typename CoordsType, typename Allocator>
+unsigned Grid<T, CoordsType, Allocator>::batch_indices(const coords_type* coords, const std::size_t count, std::array<int, batch_size>& indices) const
+{
+    assert(count <= batch_size);
+
+#if defined(__AVX2__)
+    if constexpr (use_avx2) {
+        if (count == batch_size) {
+            __m256i mask;
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(indices.data()), batch_indices_avx2(coords, mask));
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+        }
+    }
+#endif
+
+    unsigned valid = 0;
+
+    for (std::size_t j = 0; j < count; ++j) {
+        const auto x = static_cast<int>(coords[j].col());
+        const auto y = static_cast<int>(coords[j].row());
+        const bool inside = (static_cast<unsigned>(x) < static_cast<unsigned>(cols_)) & (static_cast<unsigned>(y) < static_cast<unsigned>(rows_));
+
+        indices[j] = inside ? y * cols_ + x : 0;
+        valid |= static_cast<unsigned>(inside) << j;
+    }
+
+    return valid;
+}
+
+#if defined(__AVX2__)
+template <typename T, typename CoordsType, typename Allocator>
+__m256i Grid<T, CoordsType, Allocator>::batch_indices_avx2(const coords_type* coords, __m256i& mask) const
+{
+    // load x0 y0 x1 y1 x2 y2 x3 y3 | x4 y4 ... and deinterleave into x0..x7 and y0..y7
+    const __m256i deinterleave = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    const __m256i lo = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(coords)), deinterleave);
+    const __m256i hi = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(coords + 4)), deinterleave);
+    const __m256i x = _mm256_permute2x128_si256(lo, hi, 0x20);
+    const __m256i y = _mm256_permute2x128_si256(lo, hi, 0x31);
+
+    // 0 <= x < cols && 0 <= y < rows
+    const __m256i cols = _mm256_set1_epi32(cols_);
+    const __m256i rows = _mm256_set1_epi32(rows_);
+    const __m256i minus_one = _mm256_set1_epi32(-1);
+    const __m256i x_inside = _mm256_and_si256(_mm256_cmpgt_epi32(x, minus_one), _mm256_cmpgt_epi32(cols, x));
+    const __m256i y_inside = _mm256_and_si256(_mm256_cmpgt_epi32(y, minus_one), _mm256_cmpgt_epi32(rows, y));
+    mask = _mm256_and_si256(x_inside, y_inside);
+
+    return _mm256_and_si256(_mm256_add_epi32(_mm256_mullo_epi32(y, cols), x), mask);
+}
+#endif
+
+// Grid allocating its values from a std::pmr::memory_resource, for example an arena that is released all at once.
+template <typename T = int, typename CoordsType = Coords<int>>
+using PmrGrid = Grid<T, CoordsType, std::pmr::polymorphic_allocator<T>>;
@@ -3,6 +3,7 @@
 #include <cassert>
 
 #include "coords.hpp"
+#include "neighborhood.hpp"
 
 template <typename GridPointer, typename CoordsType>
 class GridCell : public CoordsType {
@@ -15,6 +16,26 @@ public:
 
     [[nodiscard]] auto& value() { return grid_->at(*this); }
 
+    // Neighborhood only knows rows and columns, so the neighbors are limited to cells of 2D row-major grids.
+    [[nodiscard]] auto neighbors4(const BorderMode mode = BorderMode::skip) const
+        requires PlanarCoords<CoordsType> && RowMajorGrid<GridPointer>
+    {
+        return Neighborhood<GridPointer, CoordsType, 1, false>{grid_, *this, mode};
+    }
+
+    [[nodiscard]] auto neighbors8(const BorderMode mode = BorderMode::skip) const
+        requires PlanarCoords<CoordsType> && RowMajorGrid<GridPointer>
+    {
+        return Neighborhood<GridPointer, CoordsType, 1, true>{grid_, *this, mode};
+    }
+
+    template <int Radius>
+    [[nodiscard]] auto neighborhood(const BorderMode mode = BorderMode::skip) const
+        requires PlanarCoords<CoordsType> && RowMajorGrid<GridPointer>
+    {
+        return Neighborhood<GridPointer, CoordsType, Radius, true>{grid_, *this, mode};
+    }
+
 private:
     GridPointer grid_;
 };
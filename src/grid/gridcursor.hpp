@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cassert>
+#include <compare>
+#include <cstddef>
+
+#if defined(GRID_ACCESS_TRACING)
+#include "access_trace.hpp"
+#endif
+
+#include "coords.hpp"
+#include "neighborhood.hpp"
+
+// Like GridCell, but keeps the linear offset of the current cell next to its coordinates, so moving the cursor
+// only adds to the offset and value() is a single indexed load instead of recalculating row * width + col.
+template <typename GridPointer, typename CoordsType>
+class GridCursor {
+public:
+    using coords_type = CoordsType;
+    using coordinates_type = typename CoordsType::coordinates_type;
+    using pointer = decltype(std::declval<GridPointer>()->data());
+    using difference_type = std::ptrdiff_t;
+
+    GridCursor(GridPointer grid, const CoordsType& coords) : coords_(coords)
+    {
+        assert(grid != nullptr);
+        grid_ = grid;
+        data_ = grid->data();
+        width_ = grid->width();
+        offset_ = static_cast<difference_type>(coords.row()) * width_ + coords.col();
+    }
+
+    [[nodiscard]] auto& value() const
+    {
+        assert(coords_.col() >= 0 && coords_.col() < grid_->width());
+        assert(coords_.row() >= 0 && coords_.row() < grid_->height());
+#if defined(GRID_ACCESS_TRACING)
+        trace_access(&data_[offset_]);
+#endif
+        return data_[offset_];
+    }
+
+    [[nodiscard]] difference_type index() const { return offset_; }
+
+    [[nodiscard]] const coords_type& coords() const { return coords_; }
+    operator const coords_type&() const { return coords_; }
+
+    [[nodiscard]] coordinates_type col() const { return coords_.col(); }
+    [[nodiscard]] coordinates_type row() const { return coords_.row(); }
+
+    void move(const int dx, const int dy)
+    {
+        coords_.move(dx, dy);
+        offset_ += dy * width_ + dx;
+    }
+
+    void move(const coords_type& delta) { move(delta.col(), delta.row()); }
+
+    void move_horizontally(const int distance)
+    {
+        coords_.move_horizontally(distance);
+        offset_ += distance;
+    }
+
+    void move_vertically(const int distance)
+    {
+        coords_.move_vertically(distance);
+        offset_ += distance * width_;
+    }
+
+    void move_up(const int distance = 1) { move_vertically(-distance); }
+    void move_down(const int distance = 1) { move_vertically(distance); }
+    void move_left(const int distance = 1) { move_horizontally(-distance); }
+    void move_right(const int distance = 1) { move_horizontally(distance); }
+
+    void move_north(const int distance = 1) { move_vertically(-distance); }
+    void move_south(const int distance = 1) { move_vertically(distance); }
+    void move_west(const int distance = 1) { move_horizontally(-distance); }
+    void move_east(const int distance = 1) { move_horizontally(distance); }
+
+    [[nodiscard]] auto neighbors4(const BorderMode mode = BorderMode::skip) const { return Neighborhood<GridPointer, CoordsType, 1, false>{grid_, coords_, mode}; }
+    [[nodiscard]] auto neighbors8(const BorderMode mode = BorderMode::skip) const { return Neighborhood<GridPointer, CoordsType, 1, true>{grid_, coords_, mode}; }
+
+    template <int Radius>
+    [[nodiscard]] auto neighborhood(const BorderMode mode = BorderMode::skip) const { return Neighborhood<GridPointer, CoordsType, Radius, true>{grid_, coords_, mode}; }
+
+    bool operator==(const GridCursor& rhs) const { return coords_ == rhs.coords_; }
+    auto operator<=>(const GridCursor& rhs) const { return coords_ <=> rhs.coords_; }
+
+private:
+    coords_type coords_;
+    GridPointer grid_;
+    pointer data_;
+    difference_type width_;
+    difference_type offset_;
+};
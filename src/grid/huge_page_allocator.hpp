@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// Allocator for large Grids (hundreds of MB) backed by 2 MB huge pages to reduce TLB misses.
+// On Linux memory is mapped with mmap, first trying explicit huge pages (MAP_HUGETLB, only available if the system
+// has reserved some), then falling back to regular pages aligned to 2 MB with MADV_HUGEPAGE so transparent huge
+// pages can back them. Elsewhere it falls back to operator new with 2 MB alignment.
+// Every allocation is rounded up to whole huge pages, so use it for large buffers only.
+template <typename T>
+class HugePageAllocator {
+public:
+    using value_type = T;
+
+    static constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+    template <typename U>
+    struct rebind {
+        using other = HugePageAllocator<U>;
+    };
+
+    HugePageAllocator() noexcept = default;
+
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>&) noexcept { }
+
+    // leaves room to round up to whole huge pages and for the extra huge page used for aligning
+    static constexpr std::size_t max_size() noexcept { return (std::numeric_limits<std::size_t>::max() - 2 * huge_page_size) / sizeof(T); }
+
+    [[nodiscard]] T* allocate(std::size_t n);
+    void deallocate(T* p, std::size_t n) noexcept;
+
+    template <typename U>
+    bool operator==(const HugePageAllocator<U>&) const noexcept { return true; }
+
+private:
+    static std::size_t mapping_size(const std::size_t n) { return (n * sizeof(T) + huge_page_size - 1) & ~(huge_page_size - 1); }
+};
+
+template <typename T>
+T* HugePageAllocator<T>::allocate(const std::size_t n)
+{
+    if (n > max_size())
+        throw std::bad_array_new_length{};
+
+    const std::size_t size = mapping_size(n);
+
+#if defined(__linux__)
+#if defined(MAP_HUGETLB)
+    if (void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0); p != MAP_FAILED)
+        return static_cast<T*>(p);
+#endif
+
+    // over-allocate by one huge page and unmap the unaligned head and the rest of the tail
+    void* p = mmap(nullptr, size + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (p == MAP_FAILED)
+        throw std::bad_alloc{};
+
+    auto* const begin = static_cast<std::byte*>(p);
+    const auto misalignment = reinterpret_cast<std::uintptr_t>(begin) & (huge_page_size - 1);
+    const std::size_t head = misalignment == 0 ? 0 : huge_page_size - misalignment;
+    std::byte* const aligned = begin + head;
+
+    if (head > 0)
+        munmap(begin, head);
+
+    munmap(aligned + size, huge_page_size - head);
+
+#if defined(MADV_HUGEPAGE)
+    madvise(aligned, size, MADV_HUGEPAGE);  // only a hint, fails harmlessly if transparent huge pages are disabled
+#endif
+
+    return reinterpret_cast<T*>(aligned);
+#else
+    return static_cast<T*>(::operator new(size, std::align_val_t{huge_page_size}));
+#endif
+}
+
+template <typename T>
+void HugePageAllocator<T>::deallocate(T* p, const std::size_t n) noexcept
+{
+#if defined(__linux__)
+    munmap(p, mapping_size(n));
+#else
+    ::operator delete(p, mapping_size(n), std::align_val_t{huge_page_size});
+#endif
+}
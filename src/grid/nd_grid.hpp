@@ -0,0 +1,316 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "strided_iterator.hpp"
+
+// Marks an NdGrid extent that is only known at runtime (like std::dynamic_extent for mdspan).
+inline constexpr int dynamic_extent = -1;
+
+// Values along one dimension of an NdGrid or NdView.
+template <typename T>
+class NdLine {
+public:
+    using size_type = int;
+    using difference_type = std::ptrdiff_t;
+    using iterator = StridedIterator<T*, T&>;
+
+    NdLine(T* ptr, const size_type size, const difference_type stride) : ptr_{ptr}, size_{size}, stride_{stride}
+    {
+        assert(ptr != nullptr);
+        assert(size > 0);
+        assert(stride > 0);
+    }
+
+    size_type size() const { return size_; }
+
+    iterator begin() const { return iterator{ptr_, stride_}; }
+    iterator end() const { return iterator{ptr_ + size_ * stride_, stride_}; }
+
+    T& operator[](const size_type pos) const
+    {
+        assert(pos >= 0 && pos < size_);
+        return ptr_[pos * stride_];
+    }
+
+private:
+    T* ptr_;
+    size_type size_;
+    difference_type stride_;
+};
+
+// Rank-N window into the values of an NdGrid with runtime extents and strides, for example a slice.
+// Dimension 0 is the innermost (x), like columns in Grid.
+template <typename T, std::size_t N>
+class NdView {
+public:
+    using size_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+    using extents_type = std::array<size_type, N>;
+    using strides_type = std::array<difference_type, N>;
+
+    static_assert(N > 0);
+
+    NdView(pointer data, const extents_type& extents, const strides_type& strides) : data_{data}, extents_{extents}, strides_{strides} { assert(data != nullptr); }
+
+    static constexpr std::size_t rank() { return N; }
+
+    size_type extent(const std::size_t dim) const { return extents_[dim]; }
+    difference_type stride(const std::size_t dim) const { return strides_[dim]; }
+
+    size_type size() const
+    {
+        size_type size = 1;
+
+        for (const auto extent : extents_)
+            size *= extent;
+
+        return size;
+    }
+
+    pointer data() const { return data_; }
+
+    template <std::integral... Indices>
+    requires(sizeof...(Indices) == N)
+    [[nodiscard]] reference operator()(const Indices... indices) const { return at(extents_type{static_cast<size_type>(indices)...}); }
+
+    [[nodiscard]] reference at(const extents_type& indices) const
+    {
+        difference_type offset = 0;
+
+        for (std::size_t dim = 0; dim < N; ++dim) {
+            assert(indices[dim] >= 0 && indices[dim] < extents_[dim]);
+            offset += indices[dim] * strides_[dim];
+        }
+
+        return data_[offset];
+    }
+
+    template <std::size_t D>
+    requires(D < N && N > 1)
+    [[nodiscard]] NdView<T, N - 1> slice(const size_type pos) const
+    {
+        assert(pos >= 0 && pos < extents_[D]);
+        return NdView<T, N - 1>{data_ + pos * strides_[D], remove_dim<D>(extents_), remove_dim<D>(strides_)};
+    }
+
+    // the values along dimension D through the given indices (the index for D is ignored)
+    template <std::size_t D>
+    requires(D < N)
+    [[nodiscard]] NdLine<T> line(extents_type indices) const
+    {
+        indices[D] = 0;
+        return NdLine<T>{&at(indices), extents_[D], strides_[D]};
+    }
+
+    // Calls f(value) for all values, dimension 0 in the innermost loop.
+    template <typename F>
+    void for_each(F f) const { for_each_impl<N - 1>(data_, f); }
+
+private:
+    pointer data_;
+    extents_type extents_;
+    strides_type strides_;
+
+    // the array without element D
+    template <std::size_t D, typename V>
+    static constexpr std::array<V, N - 1> remove_dim(const std::array<V, N>& values)
+    {
+        std::array<V, N - 1> result{};
+
+        for (std::size_t i = 0, j = 0; i < N; ++i)
+            if (i != D)
+                result[j++] = values[i];
+
+        return result;
+    }
+
+    template <std::size_t D, typename F>
+    void for_each_impl(const pointer base, F& f) const
+    {
+        if constexpr (D == 0) {
+            for (size_type i = 0; i < extents_[0]; ++i)
+                f(base[i * strides_[0]]);
+        } else {
+            for (size_type i = 0; i < extents_[D]; ++i)
+                for_each_impl<D - 1>(base + i * strides_[D], f);
+        }
+    }
+};
+
+// Rank-N generalization of Grid: values stored densely with dimension 0 (x) fastest, then dimension 1 (y) and so on.
+// Each extent is either fixed at compile time or dynamic_extent (all dynamic if no extents are given), like mdspan.
+// Strides are calculated per dimension at compile time from the static extents, index calculations are unrolled
+// with fold expressions and for_each_indexed() generates one nested loop per dimension at compile time, so with
+// static extents all of it reduces to constants and the innermost loop walks contiguous memory.
+template <typename T, std::size_t N, int... StaticExtents>
+class NdGrid {
+public:
+    using size_type = int;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = T*;
+    using reference = T&;
+    using const_pointer = const T*;
+    using const_reference = const T&;
+    using extents_type = std::array<size_type, N>;
+    using view_type = NdView<T, N>;
+    using const_view_type = NdView<const T, N>;
+
+    static_assert(N > 0);
+    static_assert(sizeof...(StaticExtents) == 0 || sizeof...(StaticExtents) == N, "give either no or all N extents");
+    static_assert(((StaticExtents > 0 || StaticExtents == dynamic_extent) && ...), "extents must be positive or dynamic_extent");
+
+private:
+    static constexpr extents_type static_extents_ = [] {
+        extents_type extents{};
+
+        if constexpr (sizeof...(StaticExtents) == 0)
+            extents.fill(dynamic_extent);
+        else
+            extents = extents_type{StaticExtents...};
+
+        return extents;
+    }();
+
+    static constexpr std::size_t dynamic_count = sizeof...(StaticExtents) == 0 ? N : ((StaticExtents == dynamic_extent ? 1 : 0) + ... + 0);
+
+public:
+    static constexpr std::size_t rank() { return N; }
+    static constexpr std::size_t rank_dynamic() { return dynamic_count; }
+    static constexpr size_type static_extent(const std::size_t dim) { return static_extents_[dim]; }
+
+    // dynamic extents only, in dimension order
+    explicit NdGrid(const std::array<size_type, dynamic_count>& dynamic_extents, const T& value = T{});
+
+    template <std::integral... Extents>
+    requires(sizeof...(Extents) == dynamic_count)
+    explicit NdGrid(const Extents... dynamic_extents) : NdGrid(std::array<size_type, dynamic_count>{static_cast<size_type>(dynamic_extents)...}) { }
+
+    template <std::size_t D>
+    [[nodiscard]] constexpr size_type extent() const
+    {
+        if constexpr (static_extent(D) != dynamic_extent)
+            return static_extent(D);
+        else
+            return extents_[D];
+    }
+
+    size_type extent(const std::size_t dim) const { return extents_[dim]; }
+
+    template <std::size_t D>
+    [[nodiscard]] constexpr difference_type stride() const
+    {
+        if constexpr (D == 0)
+            return 1;
+        else
+            return stride<D - 1>() * extent<D - 1>();
+    }
+
+    size_type size() const { return static_cast<size_type>(data_.size()); }
+
+    pointer data() { return data_.data(); }
+    const_pointer data() const { return data_.data(); }
+
+    auto begin() { return data_.begin(); }
+    auto begin() const { return data_.cbegin(); }
+    auto end() { return data_.end(); }
+    auto end() const { return data_.cend(); }
+
+    template <std::integral... Indices>
+    requires(sizeof...(Indices) == N)
+    [[nodiscard]] reference operator()(const Indices... indices) { return data_[static_cast<std::size_t>(offset(std::make_index_sequence<N>{}, extents_type{static_cast<size_type>(indices)...}))]; }
+
+    template <std::integral... Indices>
+    requires(sizeof...(Indices) == N)
+    [[nodiscard]] const_reference operator()(const Indices... indices) const { return data_[static_cast<std::size_t>(offset(std::make_index_sequence<N>{}, extents_type{static_cast<size_type>(indices)...}))]; }
+
+    [[nodiscard]] reference at(const extents_type& indices) { return data_[static_cast<std::size_t>(offset(std::make_index_sequence<N>{}, indices))]; }
+    [[nodiscard]] const_reference at(const extents_type& indices) const { return data_[static_cast<std::size_t>(offset(std::make_index_sequence<N>{}, indices))]; }
+
+    [[nodiscard]] view_type view() { return view_type{data(), extents_, strides(std::make_index_sequence<N>{})}; }
+    [[nodiscard]] const_view_type view() const { return const_view_type{data(), extents_, strides(std::make_index_sequence<N>{})}; }
+
+    template <std::size_t D>
+    [[nodiscard]] auto slice(const size_type pos) { return view().template slice<D>(pos); }
+
+    template <std::size_t D>
+    [[nodiscard]] auto slice(const size_type pos) const { return view().template slice<D>(pos); }
+
+    template <std::size_t D>
+    [[nodiscard]] auto line(const extents_type& indices) { return view().template line<D>(indices); }
+
+    template <std::size_t D>
+    [[nodiscard]] auto line(const extents_type& indices) const { return view().template line<D>(indices); }
+
+    // Calls f(indices, value) for all values, with one loop per dimension generated at compile time.
+    template <typename F>
+    void for_each_indexed(F f)
+    {
+        extents_type indices{};
+        for_each_indexed_impl<N - 1>(data(), indices, f);
+    }
+
+    template <typename F>
+    void for_each_indexed(F f) const
+    {
+        extents_type indices{};
+        for_each_indexed_impl<N - 1>(data(), indices, f);
+    }
+
+private:
+    extents_type extents_;
+    std::vector<T> data_;
+
+    template <std::size_t... Is>
+    [[nodiscard]] difference_type offset(std::index_sequence<Is...>, const extents_type& indices) const
+    {
+        assert(((indices[Is] >= 0 && indices[Is] < extent<Is>()) && ...));
+        return ((indices[Is] * stride<Is>()) + ...);
+    }
+
+    template <std::size_t... Is>
+    [[nodiscard]] std::array<difference_type, N> strides(std::index_sequence<Is...>) const { return {stride<Is>()...}; }
+
+    template <std::size_t D, typename Pointer, typename F>
+    void for_each_indexed_impl(const Pointer base, extents_type& indices, F& f) const
+    {
+        if constexpr (D == 0) {
+            for (indices[0] = 0; indices[0] < extent<0>(); ++indices[0])
+                f(std::as_const(indices), base[indices[0]]);
+        } else {
+            for (indices[D] = 0; indices[D] < extent<D>(); ++indices[D])
+                for_each_indexed_impl<D - 1>(base + indices[D] * stride<D>(), indices, f);
+        }
+    }
+};
+
+template <typename T, std::size_t N, int... StaticExtents>
+NdGrid<T, N, StaticExtents...>::NdGrid(const std::array<size_type, dynamic_count>& dynamic_extents, const T& value)
+{
+    extents_ = static_extents_;
+
+    if constexpr (dynamic_count > 0) {
+        std::size_t next_dynamic = 0;
+
+        for (auto& extent : extents_)
+            if (extent == dynamic_extent)
+                extent = dynamic_extents[next_dynamic++];
+    }
+
+    std::size_t size = 1;
+
+    for (const auto extent : extents_) {
+        assert(extent > 0);
+        size *= static_cast<std::size_t>(extent);
+    }
+
+    data_ = std::vector<T>(size, value);
+}
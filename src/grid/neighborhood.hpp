@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#if defined(GRID_ACCESS_TRACING)
+#include "access_trace.hpp"
+#endif
+
+// How to handle neighbors outside of the grid: leave them out, use the nearest cell on the border
+// or wrap around to the opposite side.
+enum class BorderMode {
+    skip,
+    clamp,
+    wrap
+};
+
+// Coordinates in a plane, Coords3 and other coordinates with a slice() are not.
+template <typename CoordsType>
+concept PlanarCoords = requires(const CoordsType& coords) {
+    { coords.col() } -> std::convertible_to<int>;
+    { coords.row() } -> std::convertible_to<int>;
+} && !requires(const CoordsType& coords) { coords.slice(); };
+
+// A grid of width() * height() values stored row by row from data(), the layout Neighborhood indexes into.
+template <typename GridPointer>
+concept RowMajorGrid = requires(const GridPointer& grid) {
+    { grid->width() } -> std::convertible_to<int>;
+    { grid->height() } -> std::convertible_to<int>;
+    { grid->data() } -> std::convertible_to<const void*>;
+} && !requires(const GridPointer& grid) { grid->depth(); };
+
+// The cells around a center cell, excluding the center itself. With Diagonals all cells within a square of the
+// given radius (Moore neighborhood), otherwise all cells within the given Manhattan distance (von Neumann).
+// The neighbors are resolved to pointers once on construction: in the interior of the grid this only adds
+// compile-time offsets to the center without any per-neighbor checks, only cells near the border take the slow path.
+template <typename GridPointer, typename CoordsType, int Radius, bool Diagonals, bool YieldCells = false>
+class Neighborhood {
+public:
+    using pointer = decltype(std::declval<GridPointer>()->data());
+    using reference = decltype(*std::declval<pointer>());
+    using cell_type = decltype(std::declval<GridPointer>()->cell(std::declval<CoordsType>()));
+    using value_type = std::conditional_t<YieldCells, cell_type, std::remove_cvref_t<reference>>;
+    using difference_type = std::ptrdiff_t;
+    using size_type = int;
+
+    static_assert(Radius > 0);
+
+private:
+    struct Offset {
+        int dx;
+        int dy;
+    };
+
+    static constexpr auto max_neighbors = static_cast<std::size_t>(Diagonals ? (2 * Radius + 1) * (2 * Radius + 1) - 1 : 2 * Radius * (Radius + 1));
+
+    static constexpr std::array<Offset, max_neighbors> offsets()
+    {
+        std::array<Offset, max_neighbors> offsets{};
+        std::size_t i = 0;
+
+        for (int dy = -Radius; dy <= Radius; ++dy)
+            for (int dx = -Radius; dx <= Radius; ++dx)
+                if ((dx != 0 || dy != 0) && (Diagonals || (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy) <= Radius))
+                    offsets[i++] = Offset{dx, dy};
+
+        return offsets;
+    }
+
+    class Iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Neighborhood::value_type;
+        using difference_type = Neighborhood::difference_type;
+
+        Iterator() : neighborhood_{}, pos_{} { }
+        Iterator(const Neighborhood* neighborhood, const difference_type pos) : neighborhood_{neighborhood}, pos_{pos} { }
+
+        decltype(auto) operator*() const { return (*neighborhood_)[static_cast<size_type>(pos_)]; }
+
+        Iterator& operator++()
+        {
+            ++pos_;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            const Iterator tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+
+        Iterator& operator--()
+        {
+            --pos_;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            const Iterator tmp{*this};
+            --(*this);
+            return tmp;
+        }
+
+        Iterator& operator+=(const difference_type off)
+        {
+            pos_ += off;
+            return *this;
+        }
+
+        Iterator& operator-=(const difference_type off)
+        {
+            pos_ -= off;
+            return *this;
+        }
+
+        Iterator operator+(const difference_type off) const { return Iterator{neighborhood_, pos_ + off}; }
+        Iterator operator-(const difference_type off) const { return Iterator{neighborhood_, pos_ - off}; }
+        friend Iterator operator+(const difference_type off, const Iterator& a) { return Iterator{a.neighborhood_, a.pos_ + off}; }
+        friend difference_type operator-(const Iterator& a, const Iterator& b) { return a.pos_ - b.pos_; }
+
+        decltype(auto) operator[](const difference_type off) const { return *(*this + off); }
+
+        auto operator<=>(const Iterator& rhs) const { return pos_ <=> rhs.pos_; }
+        bool operator==(const Iterator& rhs) const { return pos_ == rhs.pos_; }
+
+    private:
+        const Neighborhood* neighborhood_;
+        difference_type pos_;
+    };
+
+public:
+    using iterator = Iterator;
+
+    Neighborhood(GridPointer grid, const CoordsType& center, BorderMode mode);
+
+    template <bool OtherYieldCells>
+    explicit Neighborhood(const Neighborhood<GridPointer, CoordsType, Radius, Diagonals, OtherYieldCells>& other) : grid_{other.grid_}, size_{other.size_}, neighbors_{other.neighbors_} { }
+
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    iterator begin() const { return iterator{this, 0}; }
+    iterator end() const { return iterator{this, size_}; }
+
+    [[nodiscard]] CoordsType coords(const size_type pos) const
+    {
+        assert(pos >= 0 && pos < size_);
+        const auto idx = static_cast<int>(neighbors_[static_cast<std::size_t>(pos)] - grid_->data());
+        return CoordsType{static_cast<typename CoordsType::coordinates_type>(idx % grid_->width()), static_cast<typename CoordsType::coordinates_type>(idx / grid_->width())};
+    }
+
+    [[nodiscard]] auto cell(const size_type pos) const { return grid_->cell(coords(pos)); }
+    [[nodiscard]] reference value(const size_type pos) const
+    {
+#if defined(GRID_ACCESS_TRACING)
+        trace_access(neighbors_[static_cast<std::size_t>(pos)]);
+#endif
+        return *neighbors_[static_cast<std::size_t>(pos)];
+    }
+
+    decltype(auto) operator[](const size_type pos) const
+    {
+        if constexpr (YieldCells)
+            return cell(pos);
+        else
+            return value(pos);
+    }
+
+    // The same neighbors, but iterating over them yields GridCells instead of values.
+    [[nodiscard]] auto cells() const { return Neighborhood<GridPointer, CoordsType, Radius, Diagonals, true>{*this}; }
+
+private:
+    template <typename, typename, int, bool, bool>
+    friend class Neighborhood;
+
+    GridPointer grid_;
+    size_type size_;
+    std::array<pointer, max_neighbors> neighbors_;
+};
+
+template <typename GridPointer, typename CoordsType, int Radius, bool Diagonals, bool YieldCells>
+Neighborhood<GridPointer, CoordsType, Radius, Diagonals, YieldCells>::Neighborhood(GridPointer grid, const CoordsType& center, const BorderMode mode)
+{
+    assert(grid != nullptr);
+    grid_ = grid;
+
+    constexpr auto neighbor_offsets = offsets();
+    const int width = grid->width();
+    const int height = grid->height();
+    const int x = center.col();
+    const int y = center.row();
+
+    assert(x >= 0 && x < width);
+    assert(y >= 0 && y < height);
+
+    if (x >= Radius && x < width - Radius && y >= Radius && y < height - Radius) {
+        const pointer center_ptr = grid->data() + (y * width + x);
+
+        for (std::size_t i = 0; i < neighbor_offsets.size(); ++i)
+            neighbors_[i] = center_ptr + (neighbor_offsets[i].dy * width + neighbor_offsets[i].dx);
+
+        size_ = static_cast<size_type>(max_neighbors);
+    } else {
+        size_ = 0;
+
+        for (const auto& offset : neighbor_offsets) {
+            int nx = x + offset.dx;
+            int ny = y + offset.dy;
+
+            if (nx < 0 || nx >= width || ny < 0 || ny >= height) {
+                switch (mode) {
+                    case BorderMode::skip:
+                        continue;
+                    case BorderMode::clamp:
+                        nx = std::clamp(nx, 0, width - 1);
+                        ny = std::clamp(ny, 0, height - 1);
+                        break;
+                    case BorderMode::wrap:
+                        nx = (nx % width + width) % width;
+                        ny = (ny % height + height) % height;
+                        break;
+                }
+            }
+
+            neighbors_[static_cast<std::size_t>(size_++)] = grid->data() + (ny * width + nx);
+        }
+    }
+}
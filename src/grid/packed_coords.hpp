@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "coords_hash.hpp"
+
+// Coordinates packed into a single integer of twice the size of PackedCoordinatesType: x in the upper half, y in the
+// lower half. Signed coordinates are stored with a bias (the sign bit of each half flipped), so comparing the packed
+// integers orders like Coords (x first, then y) in a single comparison.
+// Addition and subtraction work on both halves at once (SWAR) and wrap around inside each half.
+// By default each half is as wide as CoordinatesType, so PackedCoords<T> is as large as Coords<T>. A narrower
+// PackedCoordinatesType limits the range of the coordinates (see max()) and halves the size, for example
+// PackedCoords<int, std::int16_t> takes 4 bytes instead of the 8 of Coords<int>.
+template <typename CoordinatesType = int, typename PackedCoordinatesType = CoordinatesType>
+class PackedCoords {
+public:
+    using coordinates_type = CoordinatesType;
+    using packed_coordinates_type = PackedCoordinatesType;
+
+    static_assert(std::is_integral_v<coordinates_type> && std::is_integral_v<packed_coordinates_type>);
+    static_assert(std::numeric_limits<coordinates_type>::digits <= std::numeric_limits<int>::digits, "maximum supported coordinates type is int32");
+    static_assert(std::is_signed_v<packed_coordinates_type> == std::is_signed_v<coordinates_type>, "the packed coordinates need the same signedness");
+    static_assert(sizeof(packed_coordinates_type) <= sizeof(coordinates_type), "the packed coordinates cannot be wider than the coordinates");
+
+private:
+    using lane_type = std::make_unsigned_t<packed_coordinates_type>;
+
+public:
+    using storage_type = std::conditional_t<sizeof(lane_type) == 1, std::uint16_t, std::conditional_t<sizeof(lane_type) == 2, std::uint32_t, std::uint64_t>>;
+
+    PackedCoords() : value_{pack(encode(0), encode(0))} { }
+    PackedCoords(coordinates_type x_coord, coordinates_type y_coord) : value_{pack(encode(x_coord), encode(y_coord))} { }
+
+    static coordinates_type max() { return std::numeric_limits<packed_coordinates_type>::max(); }
+
+    [[nodiscard]] static PackedCoords from_packed(const storage_type value)
+    {
+        PackedCoords coords;
+        coords.value_ = value;
+        return coords;
+    }
+
+    [[nodiscard]] storage_type packed() const { return value_; }
+
+    [[nodiscard]] coordinates_type col() const { return decode(static_cast<lane_type>(value_ >> lane_bits)); }
+    [[nodiscard]] coordinates_type row() const { return decode(static_cast<lane_type>(value_)); }
+
+    // deltas are added unbiased, which keeps the bias of the coordinates intact
+    void move(const int dx, const int dy) { value_ = swar_add(value_, pack(static_cast<lane_type>(dx), static_cast<lane_type>(dy))); }
+    void move(const PackedCoords& delta) { *this += delta; }
+
+    void move_horizontally(const int distance) { move(distance, 0); }
+    void move_vertically(const int distance) { move(0, distance); }
+
+    void move_up(const int distance = 1) { move_vertically(-distance); }
+    void move_down(const int distance = 1) { move_vertically(distance); }
+    void move_left(const int distance = 1) { move_horizontally(-distance); }
+    void move_right(const int distance = 1) { move_horizontally(distance); }
+
+    void move_north(const int distance = 1) { move_vertically(-distance); }
+    void move_south(const int distance = 1) { move_vertically(distance); }
+    void move_west(const int distance = 1) { move_horizontally(-distance); }
+    void move_east(const int distance = 1) { move_horizontally(distance); }
+
+    // both operands are biased: (a + bias) + (b + bias) = a + b + 2 * bias, and 2 * bias wraps around to 0 inside of
+    // each half, so flipping the sign bits once more restores the bias (same for subtraction)
+    PackedCoords operator+(const PackedCoords& other) const { return from_packed(static_cast<storage_type>(swar_add(value_, other.value_) ^ bias)); }
+    PackedCoords operator-(const PackedCoords& other) const { return from_packed(static_cast<storage_type>(swar_sub(value_, other.value_) ^ bias)); }
+
+    PackedCoords& operator+=(const PackedCoords& other) { return *this = *this + other; }
+    PackedCoords& operator-=(const PackedCoords& other) { return *this = *this - other; }
+
+    bool operator==(const PackedCoords& rhs) const = default;
+    std::strong_ordering operator<=>(const PackedCoords& rhs) const { return value_ <=> rhs.value_; }
+
+private:
+    static constexpr int lane_bits = std::numeric_limits<lane_type>::digits;
+    static constexpr auto high_bits = static_cast<storage_type>((storage_type{1} << (lane_bits - 1)) | (storage_type{1} << (2 * lane_bits - 1)));
+    static constexpr storage_type bias = std::is_signed_v<coordinates_type> ? high_bits : storage_type{0};
+
+    storage_type value_;
+
+    static lane_type encode(const coordinates_type coord)
+    {
+        assert(std::in_range<packed_coordinates_type>(coord));
+        return static_cast<lane_type>(static_cast<lane_type>(coord) ^ static_cast<lane_type>(bias));
+    }
+
+    static coordinates_type decode(const lane_type lane) { return static_cast<packed_coordinates_type>(static_cast<lane_type>(lane ^ static_cast<lane_type>(bias))); }
+
+    static storage_type pack(const lane_type x, const lane_type y) { return static_cast<storage_type>((storage_type{x} << lane_bits) | storage_type{y}); }
+
+    // add/subtract the lower bits of both halves, so no carry/borrow crosses from y into x, then fix up the top bits
+    static storage_type swar_add(const storage_type a, const storage_type b) { return static_cast<storage_type>(((a & ~high_bits) + (b & ~high_bits)) ^ ((a ^ b) & high_bits)); }
+    static storage_type swar_sub(const storage_type a, const storage_type b) { return static_cast<storage_type>(((a | high_bits) - (b & ~high_bits)) ^ ((a ^ ~b) & high_bits)); }
+};
+
+template <typename CoordinatesType, typename PackedCoordinatesType>
+struct std::hash<PackedCoords<CoordinatesType, PackedCoordinatesType>> {
+    std::size_t operator()(const PackedCoords<CoordinatesType, PackedCoordinatesType>& coords) const noexcept
+    {
+        return mix_coords_hash(coords.packed());
+    }
+};
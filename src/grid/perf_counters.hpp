@@ -0,0 +1,179 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+enum class PerfCounter {
+    cycles,
+    instructions,
+    branch_misses,
+    l1d_misses,
+    llc_misses,
+    dtlb_misses
+};
+
+// Hardware performance counters of the calling thread (user space only) read with perf_event_open on Linux.
+// Every counter is opened on its own, so counters the CPU or kernel does not support (or does not allow, see
+// /proc/sys/kernel/perf_event_paranoid) are simply unavailable. If the PMU has to multiplex more events than it has
+// registers, values are scaled by the fraction of time each counter was actually running.
+class PerfCounters {
+public:
+    static constexpr std::size_t counter_count = 6;
+    static constexpr std::array<PerfCounter, counter_count> all_counters{PerfCounter::cycles, PerfCounter::instructions, PerfCounter::branch_misses, PerfCounter::l1d_misses, PerfCounter::llc_misses, PerfCounter::dtlb_misses};
+
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    [[nodiscard]] bool available(PerfCounter counter) const { return fds_[index(counter)] >= 0; }
+    [[nodiscard]] bool any_available() const;
+
+    void start();
+    void stop();
+
+    // counted events between start() and stop(), nothing if the counter is unavailable
+    [[nodiscard]] std::optional<double> value(PerfCounter counter) const;
+
+    [[nodiscard]] static const char* name(PerfCounter counter);
+
+private:
+    std::array<int, counter_count> fds_;
+    std::array<std::optional<double>, counter_count> values_{};
+
+    [[nodiscard]] static constexpr std::size_t index(const PerfCounter counter) { return static_cast<std::size_t>(counter); }
+};
+
+inline PerfCounters::PerfCounters()
+{
+    fds_.fill(-1);
+
+#if defined(__linux__)
+    // cache id | operation << 8 | result << 16, see perf_event_open(2)
+    constexpr auto cache_miss = [](const std::uint64_t cache) { return cache | (std::uint64_t{PERF_COUNT_HW_CACHE_OP_READ} << 8) | (std::uint64_t{PERF_COUNT_HW_CACHE_RESULT_MISS} << 16); };
+
+    for (const auto counter : all_counters) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        switch (counter) {
+            case PerfCounter::cycles:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case PerfCounter::instructions:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case PerfCounter::branch_misses:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            case PerfCounter::l1d_misses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = cache_miss(PERF_COUNT_HW_CACHE_L1D);
+                break;
+            case PerfCounter::llc_misses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = cache_miss(PERF_COUNT_HW_CACHE_LL);
+                break;
+            case PerfCounter::dtlb_misses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = cache_miss(PERF_COUNT_HW_CACHE_DTLB);
+                break;
+        }
+
+        fds_[index(counter)] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+}
+
+inline PerfCounters::~PerfCounters()
+{
+#if defined(__linux__)
+    for (const int fd : fds_)
+        if (fd >= 0)
+            close(fd);
+#endif
+}
+
+inline bool PerfCounters::any_available() const
+{
+    for (const int fd : fds_)
+        if (fd >= 0)
+            return true;
+
+    return false;
+}
+
+inline void PerfCounters::start()
+{
+#if defined(__linux__)
+    for (const int fd : fds_) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+inline void PerfCounters::stop()
+{
+#if defined(__linux__)
+    for (const int fd : fds_)
+        if (fd >= 0)
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+    for (std::size_t i = 0; i < counter_count; ++i) {
+        values_[i].reset();
+
+        // value, time enabled, time running
+        std::array<std::uint64_t, 3> data{};
+
+        if (fds_[i] < 0 || read(fds_[i], data.data(), sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0)
+            continue;
+
+        values_[i] = static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]);
+    }
+#endif
+}
+
+inline std::optional<double> PerfCounters::value(const PerfCounter counter) const
+{
+    return values_[index(counter)];
+}
+
+inline const char* PerfCounters::name(const PerfCounter counter)
+{
+    switch (counter) {
+        case PerfCounter::cycles:
+            return "cycles";
+        case PerfCounter::instructions:
+            return "instructions";
+        case PerfCounter::branch_misses:
+            return "branch misses";
+        case PerfCounter::l1d_misses:
+            return "L1D misses";
+        case PerfCounter::llc_misses:
+            return "LLC misses";
+        case PerfCounter::dtlb_misses:
+            return "dTLB misses";
+    }
+
+    return "";
+}
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <span>
+#include <vector>
+
+#include "grid.hpp"
+
+// Grid that can grow and shrink in all four directions while values keep their logical coordinates.
+// Like std::vector it reserves capacity, here in both dimensions, and keeps the values at an offset inside of the
+// reserved area, so growing by a column or row usually only fills in new values. When the capacity of a dimension
+// runs out it is doubled and the values are recentered, leaving room on both sides for further growth.
+// Growing left or up extends the coordinates into negative numbers, min_col() and min_row() return the first ones.
+template <typename T = int, typename CoordsType = Coords<int>>
+class ResizableGrid {
+public:
+    using size_type = int;
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using coords_type = CoordsType;
+    using row_type = std::span<T>;
+    using const_row_type = std::span<const T>;
+
+    ResizableGrid(size_type cols, size_type rows, const T& value = T{});
+    explicit ResizableGrid(const Grid<T, coords_type>& grid);
+
+    size_type width() const { return cols_; }
+    size_type height() const { return rows_; }
+
+    size_type size() const { return cols_ * rows_; }
+
+    size_type capacity_width() const { return capacity_cols_; }
+    size_type capacity_height() const { return capacity_rows_; }
+
+    size_type min_col() const { return min_col_; }
+    size_type min_row() const { return min_row_; }
+    size_type max_col() const { return min_col_ + cols_ - 1; }
+    size_type max_row() const { return min_row_ + rows_ - 1; }
+
+    [[nodiscard]] bool contains(const size_type col, const size_type row) const { return col >= min_col_ && col <= max_col() && row >= min_row_ && row <= max_row(); }
+
+    [[nodiscard]] reference at(size_type col, size_type row) { return data_[idx(col, row)]; }
+    [[nodiscard]] const_reference at(size_type col, size_type row) const { return data_[idx(col, row)]; }
+
+    [[nodiscard]] reference at(const coords_type& coords) { return data_[idx(coords.col(), coords.row())]; }
+    [[nodiscard]] const_reference at(const coords_type& coords) const { return data_[idx(coords.col(), coords.row())]; }
+
+    // the values of one row, contiguous in memory
+    [[nodiscard]] row_type row(const size_type row) { return row_type{&at(min_col_, row), static_cast<std::size_t>(cols_)}; }
+    [[nodiscard]] const_row_type row(const size_type row) const { return const_row_type{&at(min_col_, row), static_cast<std::size_t>(cols_)}; }
+
+    void grow_left(size_type count, const T& value = T{});
+    void grow_right(size_type count, const T& value = T{});
+    void grow_up(size_type count, const T& value = T{});
+    void grow_down(size_type count, const T& value = T{});
+
+    // changes the size at the right and bottom, keeping min_col() and min_row()
+    void resize(size_type cols, size_type rows, const T& value = T{});
+
+    void reserve(size_type capacity_cols, size_type capacity_rows);
+    void shrink_to_fit();
+
+    [[nodiscard]] Grid<T, coords_type> to_grid() const;
+
+private:
+    size_type cols_;
+    size_type rows_;
+    size_type min_col_ = 0;
+    size_type min_row_ = 0;
+
+    // reserved area and the position of (min_col_, min_row_) inside of it
+    size_type capacity_cols_;
+    size_type capacity_rows_;
+    size_type offset_col_ = 0;
+    size_type offset_row_ = 0;
+
+    std::vector<T> data_;
+
+    [[nodiscard]] inline std::size_t idx(size_type col, size_type row) const;
+    [[nodiscard]] std::size_t buffer_idx(const size_type col, const size_type row) const { return static_cast<std::size_t>(row * capacity_cols_ + col); }
+
+    static size_type grown_capacity(const size_type capacity, const size_type required) { return std::max(required, 2 * capacity); }
+
+    void reallocate(size_type capacity_cols, size_type capacity_rows, size_type offset_col, size_type offset_row);
+    void fill(size_type first_col, size_type last_col, size_type first_row, size_type last_row, const T& value);
+};
+
+template <typename T, typename CoordsType>
+ResizableGrid<T, CoordsType>::ResizableGrid(const size_type cols, const size_type rows, const T& value)
+{
+    assert(cols > 0 && rows > 0);
+    cols_ = cols;
+    rows_ = rows;
+    capacity_cols_ = cols;
+    capacity_rows_ = rows;
+    data_ = std::vector<T>(static_cast<std::size_t>(cols * rows), value);
+}
+
+template <typename T, typename CoordsType>
+ResizableGrid<T, CoordsType>::ResizableGrid(const Grid<T, coords_type>& grid) : ResizableGrid(grid.width(), grid.height())
+{
+    std::copy(grid.begin(), grid.end(), data_.begin());
+}
+
+template <typename T, typename CoordsType>
+std::size_t ResizableGrid<T, CoordsType>::idx(const size_type col, const size_type row) const
+{
+    assert(contains(col, row));
+    return buffer_idx(col - min_col_ + offset_col_, row - min_row_ + offset_row_);
+}
+
+template <typename T, typename CoordsType>
+void ResizableGrid<T, CoordsType>::grow_left(const size_type count, const T& value)
+{
+    assert(count >= 0);
+
+    if (offset_col_ < count) {
+        const size_type capacity = grown_capacity(capacity_cols_, cols_ + count);
+        reallocate(capacity, capacity_rows_, (capacity - cols_ - count) / 2 + count, offset_row_);
+    }
+
+    offset_col_ -= count;
+    min_col_ -= count;
+    cols_ += count;
+    fill(offset_col_, offset_col_ + count, offset_row_, offset_row_ + rows_, value);
+}
+
+template <typename T, typename CoordsType>
+void ResizableGrid<T, CoordsType>::grow_right(const size_type count, const T& value)
+{
+    assert(count >= 0);
+
+    if (offset_col_ + cols_ + count > capacity_cols_) {
+        const size_type capacity = grown_capacity(capacity_cols_, cols_ + count);
+        reallocate(capacity, capacity_rows_, (capacity - cols_ - count) / 2, offset_row_);
+    }
+
+    fill(offset_col_ + cols_, offset_col_ + cols_ + count, offset_row_, offset_row_ + rows_, value);
+    cols_ += count;
+}
+
+template <typename T, typename CoordsType>
+void ResizableGrid<T, CoordsType>::grow_up(const size_type count, const T& value)
+{
+    assert(count >= 0);
+
+    if (offset_row_ < count) {
+        const size_type capacity = grown_capacity(capacity_rows_, rows_ + count);
+        reallocate(capacity_cols_, capacity, offset_col_, (capacity - rows_ - count) / 2 + count);
+    }
+
+    offset_row_ -= count;
+    min_row_ -= count;
+    rows_ += count;
+    fill(offset_col_, offset_col_ + cols_, offset_row_, offset_row_ + count, value);
+}
+
+template <typename T, typename CoordsType>
+void ResizableGrid<T, CoordsType>::grow_down(const size_type count, const T& value)
+{
+    assert(count >= 0);
+
+    if (offset_row_ + rows_ + count > capacity_rows_) {
+        const size_type capacity = grown_capacity(capacity_rows_, rows_ + count);
+        reallocate(capacity_cols_, capacity, offset_col_, (capacity - rows_ - count) / 2);
+    }
+
+    fill(offset_col_, offset_col_ + cols_, offset_row_ + rows_, offset_row_ + rows_ + count, value);
+    rows_ += count;
+}
+
+template <typename T, typename CoordsType>
+void ResizableGrid<T, CoordsType>::resize(const size_type cols, const size_type rows, const T& value)
+{
+    assert(cols > 0 && rows > 0);
+
+    // shrink first so growing only fills in the new area
+    cols_ = std::min(cols_, cols);
+    rows_ = std::min(rows_, rows);
+    grow_right(cols - cols_, value);
+    grow_down(rows - rows_, value);
+}
+
+template <typename T, typename CoordsType>
+void ResizableGrid<T, CoordsType>::reserve(const size_type capacity_cols, const size_type capacity_rows)
+{
+    if (capacity_cols <= capacity_cols_ && capacity_rows <= capacity_rows_)
+        return;
+
+    const size_type cols = std::max(capacity_cols, capacity_cols_);
+    const size_type rows = std::max(capacity_rows, capacity_rows_);
+    reallocate(cols, rows, (cols - cols_) / 2, (rows - rows_) / 2);
+}
+
+template <typename T, typename CoordsType>
+void ResizableGrid<T, CoordsType>::shrink_to_fit()
+{
+    if (capacity_cols_ != cols_ || capacity_rows_ != rows_)
+        reallocate(cols_, rows_, 0, 0);
+}
+
+template <typename T, typename CoordsType>
+Grid<T, CoordsType> ResizableGrid<T, CoordsType>::to_grid() const
+{
+    Grid<T, coords_type> grid{cols_, rows_};
+
+    for (size_type y = 0; y < rows_; ++y)
+        std::copy_n(&data_[buffer_idx(offset_col_, offset_row_ + y)], cols_, &grid.at(0, y));
+
+    return grid;
+}
+
+// Moves the values into a new buffer of the given capacity, (min_col_, min_row_) ends up at (offset_col, offset_row).
+template <typename T, typename CoordsType>
+void ResizableGrid<T, CoordsType>::reallocate(const size_type capacity_cols, const size_type capacity_rows, const size_type offset_col, const size_type offset_row)
+{
+    assert(offset_col >= 0 && offset_col + cols_ <= capacity_cols);
+    assert(offset_row >= 0 && offset_row + rows_ <= capacity_rows);
+
+    std::vector<T> data(static_cast<std::size_t>(capacity_cols * capacity_rows));
+
+    for (size_type y = 0; y < rows_; ++y) {
+        const auto src = data_.begin() + static_cast<std::ptrdiff_t>(buffer_idx(offset_col_, offset_row_ + y));
+        std::move(src, src + cols_, data.begin() + (offset_row + y) * capacity_cols + offset_col);
+    }
+
+    data_ = std::move(data);
+    capacity_cols_ = capacity_cols;
+    capacity_rows_ = capacity_rows;
+    offset_col_ = offset_col;
+    offset_row_ = offset_row;
+}
+
+// Sets the values in columns [first_col, last_col) of rows [first_row, last_row) of the buffer.
+template <typename T, typename CoordsType>
+void ResizableGrid<T, CoordsType>::fill(const size_type first_col, const size_type last_col, const size_type first_row, const size_type last_row, const T& value)
+{
+    for (size_type y = first_row; y < last_row; ++y) {
+        const auto first = data_.begin() + static_cast<std::ptrdiff_t>(buffer_idx(first_col, y));
+        std::fill(first, first + (last_col - first_col), value);
+    }
+}
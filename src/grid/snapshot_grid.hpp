@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+#include "grid.hpp"
+
+// Grid with tiled, reference counted storage. Copying a SnapshotGrid (or calling snapshot()) only copies
+// one pointer per tile; a tile is cloned the first time it gets written to while another version still uses it.
+// Note that every non-const at() counts as a write, so read shared versions through a const reference.
+template <typename T = int, typename CoordsType = Coords<int>, int TileSize = 64>
+class SnapshotGrid {
+public:
+    using size_type = int;
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using coords_type = CoordsType;
+
+    static_assert(TileSize > 0 && (TileSize & (TileSize - 1)) == 0, "tile size must be a power of two");
+
+    SnapshotGrid(size_type cols, size_type rows);
+    SnapshotGrid(size_type cols, size_type rows, const T& value);
+    explicit SnapshotGrid(const Grid<T, coords_type>& grid);
+
+    size_type width() const { return cols_; }
+    size_type height() const { return rows_; }
+
+    size_type size() const { return cols_ * rows_; }
+
+    static constexpr size_type tile_size() { return TileSize; }
+    size_type tiles_width() const { return tile_cols_; }
+    size_type tiles_height() const { return tile_rows_; }
+
+    [[nodiscard]] reference at(size_type col, size_type row) { return writable_tile(col, row)[idx_in_tile(col, row)]; }
+    [[nodiscard]] const_reference at(size_type col, size_type row) const { return tile(col, row)[idx_in_tile(col, row)]; }
+
+    [[nodiscard]] reference at(const coords_type& coords) { return at(coords.col(), coords.row()); }
+    [[nodiscard]] const_reference at(const coords_type& coords) const { return at(coords.col(), coords.row()); }
+
+    [[nodiscard]] SnapshotGrid snapshot() const { return *this; }
+    [[nodiscard]] Grid<T, coords_type> to_grid() const;
+
+    [[nodiscard]] std::vector<coords_type> changed_tiles(const SnapshotGrid& other) const;
+    [[nodiscard]] size_type shared_tiles(const SnapshotGrid& other) const;
+
+private:
+    using tile_type = std::vector<T>;
+
+    size_type cols_;
+    size_type rows_;
+    size_type tile_cols_;
+    size_type tile_rows_;
+
+    std::vector<std::shared_ptr<tile_type>> tiles_;
+
+    [[nodiscard]] inline std::size_t tile_idx(size_type col, size_type row) const;
+    [[nodiscard]] inline std::size_t idx_in_tile(size_type col, size_type row) const;
+
+    [[nodiscard]] const tile_type& tile(size_type col, size_type row) const { return *tiles_[tile_idx(col, row)]; }
+    [[nodiscard]] inline tile_type& writable_tile(size_type col, size_type row);
+
+    void create_tiles(const T& value);
+};
+
+template <typename T, typename CoordsType, int TileSize>
+SnapshotGrid<T, CoordsType, TileSize>::SnapshotGrid(const size_type cols, const size_type rows) : SnapshotGrid(cols, rows, T{}) { }
+
+template <typename T, typename CoordsType, int TileSize>
+SnapshotGrid<T, CoordsType, TileSize>::SnapshotGrid(const size_type cols, const size_type rows, const T& value)
+{
+    assert(cols > 0 && rows > 0);
+    assert(cols - 1 <= coords_type::max());
+    assert(rows - 1 <= coords_type::max());
+    cols_ = cols;
+    rows_ = rows;
+    tile_cols_ = (cols + TileSize - 1) / TileSize;
+    tile_rows_ = (rows + TileSize - 1) / TileSize;
+    create_tiles(value);
+}
+
+template <typename T, typename CoordsType, int TileSize>
+SnapshotGrid<T, CoordsType, TileSize>::SnapshotGrid(const Grid<T, coords_type>& grid) : SnapshotGrid(grid.width(), grid.height())
+{
+    for (size_type row = 0; row < rows_; ++row)
+        for (size_type col = 0; col < cols_; ++col)
+            at(col, row) = grid.at(col, row);
+}
+
+template <typename T, typename CoordsType, int TileSize>
+void SnapshotGrid<T, CoordsType, TileSize>::create_tiles(const T& value)
+{
+    tiles_.reserve(static_cast<std::size_t>(tile_cols_ * tile_rows_));
+
+    for (size_type tile_row = 0; tile_row < tile_rows_; ++tile_row) {
+        for (size_type tile_col = 0; tile_col < tile_cols_; ++tile_col) {
+            const size_type cols = std::min(TileSize, cols_ - tile_col * TileSize);
+            const size_type rows = std::min(TileSize, rows_ - tile_row * TileSize);
+            tiles_.push_back(std::make_shared<tile_type>(static_cast<std::size_t>(cols * rows), value));
+        }
+    }
+}
+
+template <typename T, typename CoordsType, int TileSize>
+Grid<T, CoordsType> SnapshotGrid<T, CoordsType, TileSize>::to_grid() const
+{
+    Grid<T, coords_type> grid{cols_, rows_};
+
+    for (size_type row = 0; row < rows_; ++row)
+        for (size_type col = 0; col < cols_; ++col)
+            grid.at(col, row) = at(col, row);
+
+    return grid;
+}
+
+// Returns the coordinates of all tiles (in tile units) that no longer share their storage with the other version.
+template <typename T, typename CoordsType, int TileSize>
+std::vector<CoordsType> SnapshotGrid<T, CoordsType, TileSize>::changed_tiles(const SnapshotGrid& other) const
+{
+    assert(cols_ == other.cols_ && rows_ == other.rows_);
+
+    std::vector<coords_type> changed;
+
+    for (size_type tile_row = 0; tile_row < tile_rows_; ++tile_row) {
+        for (size_type tile_col = 0; tile_col < tile_cols_; ++tile_col) {
+            const auto i = static_cast<std::size_t>(tile_row * tile_cols_ + tile_col);
+
+            if (tiles_[i] != other.tiles_[i])
+                changed.emplace_back(static_cast<typename coords_type::coordinates_type>(tile_col), static_cast<typename coords_type::coordinates_type>(tile_row));
+        }
+    }
+
+    return changed;
+}
+
+template <typename T, typename CoordsType, int TileSize>
+typename SnapshotGrid<T, CoordsType, TileSize>::size_type SnapshotGrid<T, CoordsType, TileSize>::shared_tiles(const SnapshotGrid& other) const
+{
+    assert(cols_ == other.cols_ && rows_ == other.rows_);
+
+    size_type count = 0;
+
+    for (std::size_t i = 0; i < tiles_.size(); ++i)
+        if (tiles_[i] == other.tiles_[i])
+            ++count;
+
+    return count;
+}
+
+template <typename T, typename CoordsType, int TileSize>
+std::size_t SnapshotGrid<T, CoordsType, TileSize>::tile_idx(const size_type col, const size_type row) const
+{
+    assert(col >= 0 && col < cols_);
+    assert(row >= 0 && row < rows_);
+    return static_cast<std::size_t>((row / TileSize) * tile_cols_ + col / TileSize);
+}
+
+template <typename T, typename CoordsType, int TileSize>
+std::size_t SnapshotGrid<T, CoordsType, TileSize>::idx_in_tile(const size_type col, const size_type row) const
+{
+    const size_type tile_width = std::min(TileSize, cols_ - (col & ~(TileSize - 1)));
+    return static_cast<std::size_t>((row & (TileSize - 1)) * tile_width + (col & (TileSize - 1)));
+}
+
+template <typename T, typename CoordsType, int TileSize>
+typename SnapshotGrid<T, CoordsType, TileSize>::tile_type& SnapshotGrid<T, CoordsType, TileSize>::writable_tile(const size_type col, const size_type row)
+{
+    auto& tile = tiles_[tile_idx(col, row)];
+
+    if (tile.use_count() > 1)
+        tile = std::make_shared<tile_type>(*tile);
+    else
+        std::atomic_thread_fence(std::memory_order_acquire);  // pairs with the release of the last other version
+
+    return *tile;
+}
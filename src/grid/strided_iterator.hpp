@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#if defined(GRID_ACCESS_TRACING)
+#include "access_trace.hpp"
+#endif
+
+// Random access iterator over every stride-th value starting at a pointer, for example the values of a column
+// (stride = width) or of any line through a Grid, Volume or NdGrid.
+template <typename Pointer, typename Reference>
+class StridedIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cvref_t<Reference>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Pointer;
+    using reference = Reference;
+
+    StridedIterator() : ptr_{}, stride_{} { }
+    StridedIterator(pointer ptr, const difference_type stride)
+    {
+        assert(ptr != nullptr);
+        assert(stride > 0);
+        ptr_ = ptr;
+        stride_ = stride;
+    }
+
+    reference operator*() const
+    {
+#if defined(GRID_ACCESS_TRACING)
+        trace_access(ptr_);
+#endif
+        return *ptr_;
+    }
+
+    pointer operator->() const
+    {
+#if defined(GRID_ACCESS_TRACING)
+        trace_access(ptr_);
+#endif
+        return ptr_;
+    }
+
+    // the current value and the distance to the next one in values, for loops over raw pointers
+    pointer base() const { return ptr_; }
+    difference_type stride() const { return stride_; }
+
+    StridedIterator& operator++()
+    {
+        ptr_ += stride_;
+        return *this;
+    }
+
+    StridedIterator operator++(int)
+    {
+        const StridedIterator tmp{*this};
+        ++(*this);
+        return tmp;
+    }
+
+    StridedIterator& operator--()
+    {
+        ptr_ -= stride_;
+        return *this;
+    }
+
+    StridedIterator operator--(int)
+    {
+        const StridedIterator tmp{*this};
+        --(*this);
+        return tmp;
+    }
+
+    StridedIterator& operator+=(const difference_type off)
+    {
+        ptr_ += off * stride_;
+        return *this;
+    }
+
+    StridedIterator& operator-=(const difference_type off)
+    {
+        ptr_ -= off * stride_;
+        return *this;
+    }
+
+    StridedIterator operator+(const difference_type off) const { return StridedIterator{ptr_ + off * stride_, stride_}; }
+    StridedIterator operator-(const difference_type off) const { return StridedIterator{ptr_ - off * stride_, stride_}; }
+    friend StridedIterator operator+(const difference_type off, const StridedIterator& a) { return StridedIterator{a.ptr_ + off * a.stride_, a.stride_}; }
+    friend difference_type operator-(const StridedIterator& a, const StridedIterator& b)
+    {
+        assert(a.stride_ == b.stride_);
+        return (a.ptr_ - b.ptr_) / a.stride_;
+    }
+
+    reference operator[](const difference_type off) const { return *(*this + off); }
+
+    auto operator<=>(const StridedIterator& rhs) const { return ptr_ <=> rhs.ptr_; }
+    bool operator==(const StridedIterator& rhs) const { return ptr_ == rhs.ptr_; }
+
+private:
+    pointer ptr_;
+    difference_type stride_;
+};
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_approx.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include "../access_trace.hpp"
+#include "../access_trace_report.hpp"
+#include "../grid.hpp"
+
+// reads of the given indices
+std::vector<GridAccess> accesses_at(const std::vector<std::size_t>& indices)
+{
+    std::vector<GridAccess> accesses;
+
+    for (const auto index : indices)
+        accesses.push_back(GridAccess{index, 0, AccessKind::read});
+
+    return accesses;
+}
+
+TEST_CASE("AccessTrace")
+{
+    const std::vector<int> values(16);
+
+    SECTION("records accesses in order")
+    {
+        AccessTrace trace{8};
+        trace.record(&values[3], AccessKind::read);
+        trace.record(&values[5], AccessKind::write);
+
+        const auto accesses = trace.snapshot();
+
+        REQUIRE(accesses.size() == 2);
+        CHECK(accesses[0].address == reinterpret_cast<std::uintptr_t>(&values[3]));
+        CHECK(accesses[0].kind == AccessKind::read);
+        CHECK(accesses[1].address == reinterpret_cast<std::uintptr_t>(&values[5]));
+        CHECK(accesses[1].kind == AccessKind::write);
+        CHECK(accesses[0].thread == AccessTrace::thread_id());
+    }
+
+    SECTION("keeps the last capacity() accesses")
+    {
+        AccessTrace trace{4};
+
+        for (const auto& value : values)
+            trace.record(&value, AccessKind::read);
+
+        const auto accesses = grid_accesses(trace.snapshot(), values.data(), values.size());
+
+        CHECK(trace.recorded() == 16);
+        REQUIRE(accesses.size() == 4);
+        CHECK(accesses[0].index == 12);
+        CHECK(accesses[3].index == 15);
+
+        trace.clear();
+        CHECK(trace.snapshot().empty());
+    }
+
+    SECTION("records accesses of multiple threads")
+    {
+        AccessTrace trace{1024};
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back([&] {
+                for (const auto& value : values)
+                    trace.record(&value, AccessKind::read);
+            });
+
+        for (auto& thread : threads)
+            thread.join();
+
+        const auto accesses = trace.snapshot();
+        CHECK(accesses.size() == 4 * values.size());
+        CHECK(std::count_if(accesses.begin(), accesses.end(), [&](const Access& a) { return a.thread == accesses[0].thread; }) == static_cast<std::ptrdiff_t>(values.size()));
+    }
+
+    SECTION("trace_access() records reads through const pointers")
+    {
+        const std::size_t recorded = AccessTrace::global().recorded();
+        int value = 0;
+        const int* const_ptr = &value;
+
+        trace_access(&value);
+        trace_access(const_ptr);
+
+        const auto accesses = grid_accesses(AccessTrace::global().snapshot(), &value, 1);
+
+        REQUIRE(AccessTrace::global().recorded() == recorded + 2);
+        REQUIRE(accesses.size() >= 2);
+        CHECK(accesses[accesses.size() - 2].kind == AccessKind::write);
+        CHECK(accesses[accesses.size() - 1].kind == AccessKind::read);
+    }
+}
+
+TEST_CASE("access trace report")
+{
+    SECTION("layout_offset()")
+    {
+        CHECK(layout_offset(TraceLayout::row_major, 17, 16) == 17);
+
+        // (1, 1) is in the first 8x8 tile, (9, 0) at the beginning of the second row of the second tile
+        CHECK(layout_offset(TraceLayout::tiled, 17, 16) == 9);
+        CHECK(layout_offset(TraceLayout::tiled, 9, 16) == 65);
+        CHECK(layout_offset(TraceLayout::tiled, 8 * 16, 16) == 128);
+
+        CHECK(layout_offset(TraceLayout::morton, 0, 16) == 0);
+        CHECK(layout_offset(TraceLayout::morton, 1, 16) == 1);
+        CHECK(layout_offset(TraceLayout::morton, 16, 16) == 2);
+        CHECK(layout_offset(TraceLayout::morton, 17, 16) == 3);
+        CHECK(layout_offset(TraceLayout::morton, 2, 16) == 4);
+        CHECK(layout_offset(TraceLayout::morton, 3 * 16 + 3, 16) == 15);
+    }
+
+    SECTION("reuse_distances() counts distinct cache lines between accesses")
+    {
+        // one value per cache line: a b c a a b
+        const auto histogram = reuse_distances(accesses_at({0, 1, 2, 0, 0, 1}), 16, TraceLayout::row_major, 64);
+
+        CHECK(histogram.cold == 3);
+        CHECK(histogram.total() == 6);
+        REQUIRE(histogram.buckets.size() == 3);
+        CHECK(histogram.buckets[0] == 1);  // a a
+        CHECK(histogram.buckets[1] == 0);
+        CHECK(histogram.buckets[2] == 2);  // a (b c) a and b (c a) b
+
+        CHECK(histogram.hit_rate(1) == Catch::Approx(1.0 / 6.0));
+        CHECK(histogram.hit_rate(2) == Catch::Approx(1.0 / 6.0));
+        CHECK(histogram.hit_rate(4) == Catch::Approx(3.0 / 6.0));
+    }
+
+    SECTION("column sweeps have a shorter reuse distance in a tiled layout")
+    {
+        const int size = 64;
+        std::vector<std::size_t> indices;
+
+        for (int x = 0; x < size; ++x)
+            for (int y = 0; y < size; ++y)
+                indices.push_back(static_cast<std::size_t>(y * size + x));
+
+        const auto accesses = accesses_at(indices);
+        const auto row_major = reuse_distances(accesses, size, TraceLayout::row_major, sizeof(int));
+        const auto tiled = reuse_distances(accesses, size, TraceLayout::tiled, sizeof(int));
+
+        // a cache of 32 lines holds half of a column in row-major layout, but a whole column of 8x8 tiles
+        CHECK(row_major.hit_rate(32) == Catch::Approx(0.0));
+        CHECK(tiled.hit_rate(32) > 0.8);
+    }
+
+    SECTION("locality_heatmap() and write_pgm()")
+    {
+        const auto image = locality_heatmap(accesses_at({0, 1, 2, 3, 3, 3, 3, 3}), 4, 2, 2);
+
+        CHECK(image.at(0, 0) == 2);
+        CHECK(image.at(0, 1) == 2);
+        CHECK(image.at(1, 0) == 0);
+        CHECK(image.at(1, 1) == 4);
+
+        std::ostringstream out;
+        write_pgm(out, image);
+
+        CHECK(out.str() == std::string{"P5\n2 2\n255\n"} + std::string{'\xae', '\x00', '\xae', '\xff'});
+    }
+}
@@ -0,0 +1,34 @@
+#include <cstdint>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../aligned_allocator.hpp"
+
+TEST_CASE("AlignedAllocator")
+{
+    SECTION("allocates aligned memory")
+    {
+        AlignedAllocator<int, 64> allocator;
+
+        for (std::size_t n = 1; n <= 16; ++n) {
+            int* p = allocator.allocate(n);
+            CHECK(reinterpret_cast<std::uintptr_t>(p) % 64 == 0);
+            allocator.deallocate(p, n);
+        }
+    }
+
+    SECTION("can be used with std::vector")
+    {
+        std::vector<char, AlignedAllocator<char, 128>> vec(100, 'a');
+
+        CHECK(reinterpret_cast<std::uintptr_t>(vec.data()) % 128 == 0);
+        CHECK(vec[99] == 'a');
+    }
+
+    SECTION("all instances compare equal")
+    {
+        CHECK(AlignedAllocator<int, 64>{} == AlignedAllocator<int, 64>{});
+        CHECK(AlignedAllocator<int, 64>{} == AlignedAllocator<double, 64>{});
+    }
+}
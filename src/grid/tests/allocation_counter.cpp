@@ -0,0 +1,115 @@
+#include <numeric>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+// counts all allocations of grid_tests
+#define ALLOCATION_COUNTER_IMPLEMENT_OPERATOR_NEW
+#include "allocation_counter.hpp"
+
+#include "../grid.hpp"
+#include "../torus_view.hpp"
+
+Grid<int> create_grid_with_test_values(int cols, int rows);
+
+TEST_CASE("AllocationCounter")
+{
+    REQUIRE(AllocationCounter::operator_new_hooked());
+
+    SECTION("counts allocations and bytes")
+    {
+        const auto allocations = count_allocations([] {
+            std::vector<int> v(100);
+            v.resize(10);
+            v.shrink_to_fit();
+        });
+
+        CHECK(allocations == AllocationStats{2, 100 * sizeof(int) + 10 * sizeof(int)});
+    }
+
+    SECTION("counts a single allocation with CountingAllocator")
+    {
+        const auto allocations = count_allocations([] {
+            const std::vector<int, CountingAllocator<int>> v(100);
+            CHECK(v.size() == 100);
+        });
+
+        // the allocator and the replaced operator new both count the allocation
+        CHECK(allocations == AllocationStats{2, 2 * 100 * sizeof(int)});
+    }
+
+    SECTION("creating a Grid allocates once")
+    {
+        CHECK(count_allocations([] { const Grid<int> grid{64, 32}; }) == AllocationStats{1, 64 * 32 * sizeof(int)});
+        CHECK(count_allocations([] { const Grid<int> grid{64, 32, 42}; }) == AllocationStats{1, 64 * 32 * sizeof(int)});
+        CHECK(count_allocations([] { const auto grid = create_grid_with_test_values(64, 32); }) == AllocationStats{1, 64 * 32 * sizeof(int)});
+    }
+}
+
+TEST_CASE("Grid hot paths do not allocate")
+{
+    Grid<int> grid = create_grid_with_test_values(16, 8);
+    const Grid<int>& const_grid = grid;
+    int sum = 0;
+
+    SECTION("iteration")
+    {
+        CHECK(count_allocations([&] { sum = std::accumulate(grid.begin(), grid.end(), 0); }) == AllocationStats{});
+        CHECK(count_allocations([&] { sum = std::accumulate(const_grid.begin(), const_grid.end(), 0); }) == AllocationStats{});
+    }
+
+    SECTION("rows() and cols()")
+    {
+        CHECK(count_allocations([&] {
+            for (const auto& row : grid.rows())
+                sum += std::accumulate(row.begin(), row.end(), 0);
+
+            for (const auto& col : const_grid.cols())
+                sum += std::accumulate(col.begin(), col.end(), 0);
+        }) == AllocationStats{});
+    }
+
+    SECTION("row() and col()")
+    {
+        CHECK(count_allocations([&] {
+            for (int y = 0; y < grid.height(); ++y)
+                sum += std::accumulate(grid.row(y).begin(), grid.row(y).end(), 0);
+
+            for (int x = 0; x < grid.width(); ++x)
+                sum += std::accumulate(const_grid.col(x).begin(), const_grid.col(x).end(), 0);
+        }) == AllocationStats{});
+    }
+
+    SECTION("cell(), cursor() and neighborhoods")
+    {
+        CHECK(count_allocations([&] {
+            for (int y = 0; y < grid.height(); ++y) {
+                for (int x = 0; x < grid.width(); ++x) {
+                    auto cell = grid.cell(x, y);
+                    sum += cell.value();
+
+                    for (const auto value : cell.neighbors8())
+                        sum += value;
+
+                    sum += const_grid.cursor(x, y).value();
+                }
+            }
+        }) == AllocationStats{});
+    }
+
+    SECTION("TorusView")
+    {
+        const TorusView<Grid<int>> torus{grid};
+
+        CHECK(count_allocations([&] {
+            for (int y = -1; y <= grid.height(); ++y)
+                for (const auto value : torus.row(y, -1, grid.width() + 2))
+                    sum += value;
+
+            for (const auto value : torus.cell(0, 0).neighbors4())
+                sum += value;
+        }) == AllocationStats{});
+    }
+
+    CHECK(sum != 0);
+}
@@ -0,0 +1,106 @@
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../atomic_grid.hpp"
+
+TEST_CASE("AtomicGrid")
+{
+    SECTION("can create new AtomicGrid with default values")
+    {
+        const AtomicGrid<int> grid{4, 3, 7};
+
+        CHECK(grid.width() == 4);
+        CHECK(grid.height() == 3);
+        CHECK(grid.size() == 12);
+        CHECK(grid.load({0, 0}) == 7);
+        CHECK(grid.load({3, 2}) == 7);
+    }
+
+    SECTION("atomic operations")
+    {
+        AtomicGrid<int> grid{4, 3};
+
+        grid.store({1, 2}, 10);
+        CHECK(grid.load({1, 2}) == 10);
+
+        CHECK(grid.fetch_add({1, 2}, 5) == 10);
+        CHECK(grid.fetch_sub({1, 2}, 3) == 15);
+        CHECK(grid.load({1, 2}) == 12);
+
+        CHECK(grid.fetch_min({1, 2}, 20) == 12);
+        CHECK(grid.load({1, 2}) == 12);
+        CHECK(grid.fetch_min({1, 2}, 4) == 12);
+        CHECK(grid.load({1, 2}) == 4);
+
+        CHECK(grid.fetch_max({1, 2}, 2) == 4);
+        CHECK(grid.load({1, 2}) == 4);
+        CHECK(grid.fetch_max({1, 2}, 9) == 4);
+        CHECK(grid.load({1, 2}) == 9);
+
+        int expected = 1;
+        CHECK(grid.compare_exchange({1, 2}, expected, 100) == false);
+        CHECK(expected == 9);
+        CHECK(grid.compare_exchange({1, 2}, expected, 100));
+        CHECK(grid.load({1, 2}) == 100);
+
+        grid.atomic(3, 0).store(42);
+        CHECK(grid.load({3, 0}) == 42);
+        CHECK(grid.load({0, 0}) == 0);
+    }
+
+    SECTION("padded tiles start on their own cache line")
+    {
+        AtomicGrid<int> grid{10, 7, 0, 3, 2};
+
+        CHECK(grid.tile_width() == 3);
+        CHECK(grid.tile_height() == 2);
+
+        for (int row = 0; row < grid.height(); ++row)
+            for (int col = 0; col < grid.width(); ++col)
+                grid.store({col, row}, (row + 1) * 10 + col + 1);
+
+        const Grid<int> copy = grid.to_grid();
+
+        for (int row = 0; row < grid.height(); ++row)
+            for (int col = 0; col < grid.width(); ++col)
+                CHECK(copy.at(col, row) == (row + 1) * 10 + col + 1);
+    }
+
+    SECTION("can scatter from multiple threads")
+    {
+        AtomicGrid<int> unpadded{8, 8};
+        AtomicGrid<int> padded{8, 8, 0, 4, 4};
+        AtomicGrid<int> maximum{1, 1};
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 1000; ++i) {
+                    const Coords<int> coords{i % 8, (i / 8) % 8};
+                    unpadded.fetch_add(coords, 1, std::memory_order_relaxed);
+                    padded.fetch_add(coords, 1, std::memory_order_relaxed);
+                    maximum.fetch_max({0, 0}, i);
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        int unpadded_sum = 0;
+        int padded_sum = 0;
+
+        for (int row = 0; row < 8; ++row) {
+            for (int col = 0; col < 8; ++col) {
+                unpadded_sum += unpadded.load({col, row});
+                padded_sum += padded.load({col, row});
+            }
+        }
+
+        CHECK(unpadded_sum == 4000);
+        CHECK(padded_sum == 4000);
+        CHECK(maximum.load({0, 0}) == 999);
+    }
+}
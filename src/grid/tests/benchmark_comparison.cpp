@@ -0,0 +1,131 @@
+#include <sstream>
+#include <vector>
+
+#include "catch2/catch_approx.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include "../benchmark_comparison.hpp"
+
+TEST_CASE("BenchmarkJsonReader")
+{
+    SECTION("reads names and elapsed times of nanobench json results")
+    {
+        std::istringstream json{R"json({
+ "results": [
+  {
+   "title": "grid",
+   "name": "sum rows Grid<int, Coords<short>>: 16x16",
+   "unit": "cell",
+   "batch": 256,
+   "median(elapsed)": 3.1e-07,
+   "relative": true,
+   "other": null,
+   "measurements": [
+    {
+     "iterations": 100,
+     "elapsed": 3.0e-07,
+     "pagefaults": 0
+    },
+    {
+     "iterations": 100,
+     "elapsed": 3.2e-07,
+     "pagefaults": 0
+    }
+   ]
+  },
+  {
+   "name": "sum \"quoted\" \\ name",
+   "measurements": [{"elapsed": 1}, {"elapsed": 0}]
+  }
+ ]
+})json"};
+
+        const auto results = BenchmarkJsonReader::read(json);
+
+        REQUIRE(results);
+        REQUIRE(results->size() == 2);
+        CHECK((*results)[0].name == "sum rows Grid<int, Coords<short>>: 16x16");
+        CHECK((*results)[0].elapsed == std::vector{3.0e-07, 3.2e-07});
+        CHECK((*results)[1].name == "sum \"quoted\" \\ name");
+        CHECK((*results)[1].elapsed == std::vector{1.0});
+    }
+
+    SECTION("skips results without measurements")
+    {
+        const auto results = BenchmarkJsonReader::read(R"({"results": [{"name": "a", "measurements": []}]})");
+
+        REQUIRE(results);
+        CHECK(results->empty());
+    }
+
+    SECTION("rejects invalid json")
+    {
+        CHECK(!BenchmarkJsonReader::read(""));
+        CHECK(!BenchmarkJsonReader::read("[]"));
+        CHECK(!BenchmarkJsonReader::read(R"({"results": [{"name": "a"})"));
+        CHECK(!BenchmarkJsonReader::read(R"({"results": [{"name": "a", "measurements": [{"elapsed": x}]}]})"));
+        CHECK(!BenchmarkJsonReader::read(R"({"results": []} trailing)"));
+    }
+}
+
+TEST_CASE("compare_benchmark")
+{
+    const BenchmarkSamples baseline{"a", {1.00, 1.02, 0.98, 1.01, 0.99, 1.00, 1.03, 0.97, 1.00, 1.01, 0.99}};
+
+    SECTION("student_t_critical_value")
+    {
+        CHECK(student_t_critical_value(5.0) == Catch::Approx(4.032).margin(0.03));
+        CHECK(student_t_critical_value(10.0) == Catch::Approx(3.169).margin(0.01));
+        CHECK(student_t_critical_value(20.0) == Catch::Approx(2.845).margin(0.01));
+        CHECK(student_t_critical_value(1e9) == Catch::Approx(2.576).margin(0.001));
+    }
+
+    SECTION("reports no change for the same distribution")
+    {
+        const BenchmarkSamples current{"a", {0.99, 1.01, 1.00, 0.98, 1.02, 1.00, 0.99, 1.01, 1.03, 0.97, 1.00}};
+        const auto comparison = compare_benchmark(baseline, current, 0.05);
+
+        CHECK(comparison.result == BenchmarkChange::none);
+        CHECK(comparison.lower < 0.0);
+        CHECK(comparison.upper > 0.0);
+    }
+
+    SECTION("detects regressions and improvements")
+    {
+        BenchmarkSamples slower{"a", {}};
+        BenchmarkSamples faster{"a", {}};
+
+        for (const double e : baseline.elapsed) {
+            slower.elapsed.push_back(e * 1.2);
+            faster.elapsed.push_back(e * 0.8);
+        }
+
+        const auto regression = compare_benchmark(baseline, slower, 0.05);
+        CHECK(regression.result == BenchmarkChange::regression);
+        CHECK(regression.change == Catch::Approx(0.2));
+        CHECK(regression.lower < 0.2);
+        CHECK(regression.upper > 0.2);
+
+        const auto improvement = compare_benchmark(baseline, faster, 0.05);
+        CHECK(improvement.result == BenchmarkChange::improvement);
+        CHECK(improvement.change == Catch::Approx(-0.2));
+    }
+
+    SECTION("ignores significant changes below the threshold")
+    {
+        BenchmarkSamples slower{"a", {}};
+
+        for (const double e : baseline.elapsed)
+            slower.elapsed.push_back(e * 1.03);
+
+        CHECK(compare_benchmark(baseline, slower, 0.05).result == BenchmarkChange::none);
+        CHECK(compare_benchmark(baseline, slower, 0.01).result == BenchmarkChange::regression);
+    }
+
+    SECTION("ignores large changes with a lot of noise")
+    {
+        const BenchmarkSamples noisy{"a", {0.5, 2.0, 0.6, 1.9, 0.7, 1.8, 2.5, 0.4, 1.5, 1.2, 3.0}};
+
+        CHECK(compare_benchmark(baseline, noisy, 0.05).result == BenchmarkChange::none);
+    }
+}
@@ -0,0 +1,64 @@
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include "nanobench.h"
+
+#include "../benchmark_suite.hpp"
+
+// busy work that takes about n times as long as for n = 1
+void spin(const int n)
+{
+    volatile int counter = 0;
+
+    for (int i = 0; i < n * 1000; ++i)
+        counter = counter + 1;
+}
+
+// runs spin(n) in a suite with the given command line arguments, returns the result of finish()
+bool run_spin(const int n, std::vector<std::string> args)
+{
+    args.insert(args.begin(), "grid_benchmark");
+
+    std::vector<char*> argv;
+
+    for (auto& arg : args)
+        argv.push_back(arg.data());
+
+    const auto options = BenchmarkSuite::parse_options(std::span{argv});
+    REQUIRE(options);
+
+    BenchmarkSuite suite{*options};
+    suite.run("spin", [&] { spin(n); });
+    return suite.finish();
+}
+
+// compares spin(n) to the json results of spin(baseline_n), like grid_benchmark --baseline does
+bool compare_spin_to_baseline(const int baseline_n, const int n)
+{
+    const auto json_file = (std::filesystem::temp_directory_path() / "grid_tests_benchmark_baseline.json").string();
+
+    REQUIRE(run_spin(baseline_n, {"--json", "--output", json_file}));
+    const bool no_regressions = run_spin(n, {"--baseline", json_file});
+
+    std::filesystem::remove(json_file);
+    return no_regressions;
+}
+
+TEST_CASE("BenchmarkSuite compares nanobench results to a json baseline")
+{
+    // both sides are times per iteration, independent of how many iterations nanobench ran per epoch
+    SECTION("fails on a slowdown")
+    {
+        CHECK(!compare_spin_to_baseline(1, 10));
+    }
+
+    SECTION("passes on a speedup")
+    {
+        CHECK(compare_spin_to_baseline(10, 1));
+    }
+}
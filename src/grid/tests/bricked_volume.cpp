@@ -0,0 +1,55 @@
+#include <algorithm>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../bricked_volume.hpp"
+
+TEST_CASE("BrickedVolume")
+{
+    SECTION("pads to whole bricks")
+    {
+        const BrickedVolume<int, Coords3<int>, 4> volume{9, 4, 5, 7};
+
+        CHECK(volume.width() == 9);
+        CHECK(volume.height() == 4);
+        CHECK(volume.depth() == 5);
+        CHECK(volume.bricks_width() == 3);
+        CHECK(volume.bricks_height() == 1);
+        CHECK(volume.bricks_depth() == 2);
+        CHECK(volume.at(8, 3, 4) == 7);
+    }
+
+    SECTION("stores each brick contiguously")
+    {
+        BrickedVolume<int, Coords3<int>, 2> volume{4, 4, 4};
+
+        volume.at(2, 0, 0) = 1;
+        volume.at(3, 1, 1) = 2;
+        volume.at(Coords3{2, 1, 0}) = 3;
+
+        const auto brick = volume.brick(1, 0, 0);
+        CHECK(brick.size() == 8);
+        CHECK(brick[0] == 1);
+        CHECK(brick[2] == 3);
+        CHECK(brick[7] == 2);
+        CHECK(std::count(volume.brick(0, 0, 0).begin(), volume.brick(0, 0, 0).end(), 0) == 8);
+    }
+
+    SECTION("converts from and to Volume")
+    {
+        Volume<int> volume{10, 7, 5};
+
+        for (int z = 0; z < 5; ++z)
+            for (int y = 0; y < 7; ++y)
+                for (int x = 0; x < 10; ++x)
+                    volume.at(x, y, z) = (z * 7 + y) * 10 + x;
+
+        const BrickedVolume<int> bricked{volume};
+
+        CHECK(bricked.at(9, 6, 4) == volume.at(9, 6, 4));
+        CHECK(bricked.at(3, 5, 2) == volume.at(3, 5, 2));
+
+        const Volume<int> copy = bricked.to_volume();
+        CHECK(std::equal(copy.begin(), copy.end(), volume.begin(), volume.end()));
+    }
+}
@@ -1,5 +1,6 @@
 #include <limits>
 #include <type_traits>
+#include <vector>
 
 #include "catch2/catch_test_macros.hpp"
 #include "fmt/core.h"
@@ -217,3 +218,12 @@ TEST_CASE("Coords")
     // SECTION("uint32_t") { check_coords<Coords<uint32_t>>(); }  // not supported
     // SECTION("uint64_t") { check_coords<Coords<uint64_t>>(); }  // not supported
 }
+
+TEST_CASE("sort_by_tile()")
+{
+    std::vector<Coords<int>> coords{{5, 1}, {0, 5}, {1, 0}, {4, 4}, {0, 0}, {6, 0}, {2, 5}, {1, 1}};
+
+    sort_by_tile(std::span{coords}, 4);
+
+    CHECK(coords == std::vector<Coords<int>>{{0, 0}, {1, 0}, {1, 1}, {6, 0}, {5, 1}, {0, 5}, {2, 5}, {4, 4}});
+}
@@ -0,0 +1,67 @@
+#include <cstdint>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../coords3.hpp"
+
+template <typename CoordsType>
+void check_coords3()
+{
+    SECTION("creation")
+    {
+        CHECK(CoordsType{}.x == 0);
+        CHECK(CoordsType{}.y == 0);
+        CHECK(CoordsType{}.z == 0);
+        CHECK(CoordsType{2, 3, 4}.col() == 2);
+        CHECK(CoordsType{2, 3, 4}.row() == 3);
+        CHECK(CoordsType{2, 3, 4}.slice() == 4);
+    }
+
+    SECTION("arithmetic")
+    {
+        CoordsType a{4, 5, 6};
+
+        CHECK(a + CoordsType{2, 1, 0} == CoordsType{6, 6, 6});
+        CHECK(a - CoordsType{1, 2, 3} == CoordsType{3, 3, 3});
+
+        a += CoordsType{1, 1, 1};
+        CHECK(a == CoordsType{5, 6, 7});
+
+        a -= CoordsType{5, 6, 7};
+        CHECK(a == CoordsType{0, 0, 0});
+    }
+
+    SECTION("comparison")
+    {
+        CHECK(CoordsType{1, 2, 3} == CoordsType{1, 2, 3});
+        CHECK(CoordsType{1, 2, 3} != CoordsType{1, 2, 4});
+        CHECK(CoordsType{1, 2, 3} < CoordsType{2, 0, 0});
+        CHECK(CoordsType{1, 2, 3} < CoordsType{1, 3, 0});
+        CHECK(CoordsType{1, 2, 3} < CoordsType{1, 2, 4});
+    }
+
+    SECTION("move")
+    {
+        CoordsType a{10, 10, 10};
+
+        a.move(1, 2, 3);
+        CHECK(a == CoordsType{11, 12, 13});
+
+        a.move(CoordsType{1, 1, 1});
+        CHECK(a == CoordsType{12, 13, 14});
+
+        a.move_horizontally(-2);
+        a.move_vertically(-3);
+        a.move_in_depth(-4);
+        CHECK(a == CoordsType{10, 10, 10});
+    }
+}
+
+TEST_CASE("Coords3")
+{
+    SECTION("int8_t") { check_coords3<Coords3<int8_t>>(); }
+    SECTION("int16_t") { check_coords3<Coords3<int16_t>>(); }
+    SECTION("int32_t") { check_coords3<Coords3<int32_t>>(); }
+    SECTION("uint8_t") { check_coords3<Coords3<uint8_t>>(); }
+    SECTION("uint16_t") { check_coords3<Coords3<uint16_t>>(); }
+}
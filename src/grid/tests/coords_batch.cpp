@@ -0,0 +1,122 @@
+#include <cstdint>
+#include <vector>
+
+#include "catch2/catch_approx.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include "../coords_batch.hpp"
+
+template <typename CoordsBatchType>
+void check_coords_batch()
+{
+    using coords_type = typename CoordsBatchType::coords_type;
+
+    SECTION("creation")
+    {
+        const CoordsBatchType empty;
+        const CoordsBatchType batch1(3);
+        const CoordsBatchType batch2{{1, 2}, {3, 4}};
+
+        CHECK(empty.empty());
+        CHECK(batch1.size() == 3);
+        CHECK(batch1[2] == coords_type{0, 0});
+        CHECK(batch2.size() == 2);
+        CHECK(batch2[1] == coords_type{3, 4});
+    }
+
+    SECTION("x and y coordinates are stored in separate aligned arrays")
+    {
+        CoordsBatchType batch{{1, 2}, {3, 4}, {5, 6}};
+
+        CHECK(std::vector(batch.xs().begin(), batch.xs().end()) == std::vector<typename CoordsBatchType::coordinates_type>{1, 3, 5});
+        CHECK(std::vector(batch.ys().begin(), batch.ys().end()) == std::vector<typename CoordsBatchType::coordinates_type>{2, 4, 6});
+        CHECK(reinterpret_cast<std::uintptr_t>(batch.xs().data()) % CoordsBatchType::alignment == 0);
+        CHECK(reinterpret_cast<std::uintptr_t>(batch.ys().data()) % CoordsBatchType::alignment == 0);
+    }
+
+    SECTION("push_back() and set()")
+    {
+        CoordsBatchType batch;
+        batch.push_back({1, 2});
+        batch.push_back({3, 4});
+        batch.set(0, {5, 6});
+
+        CHECK(batch.size() == 2);
+        CHECK(batch[0] == coords_type{5, 6});
+        CHECK(batch[1] == coords_type{3, 4});
+    }
+
+    SECTION("translate()")
+    {
+        CoordsBatchType batch{{1, 2}, {3, 4}};
+
+        batch.translate(2, 1);
+        CHECK(batch[0] == coords_type{3, 3});
+        CHECK(batch[1] == coords_type{5, 5});
+
+        batch.translate(CoordsBatchType{{1, 1}, {2, 3}});
+        CHECK(batch[0] == coords_type{4, 4});
+        CHECK(batch[1] == coords_type{7, 8});
+    }
+
+    SECTION("clamp()")
+    {
+        CoordsBatchType batch{{1, 20}, {8, 4}, {30, 0}};
+
+        batch.clamp({2, 2}, {10, 10});
+        CHECK(batch[0] == coords_type{2, 10});
+        CHECK(batch[1] == coords_type{8, 4});
+        CHECK(batch[2] == coords_type{10, 2});
+    }
+
+    SECTION("in_bounds()")
+    {
+        const CoordsBatchType batch{{0, 0}, {4, 2}, {3, 3}, {3, 2}};
+        bool result[4]{};
+
+        CHECK(batch.in_bounds(4, 3, result) == 2);
+        CHECK(result[0] == true);
+        CHECK(result[1] == false);
+        CHECK(result[2] == false);
+        CHECK(result[3] == true);
+    }
+
+    SECTION("distances")
+    {
+        const CoordsBatchType batch{{1, 1}, {4, 5}, {2, 1}};
+        std::vector<int> manhattan(3);
+        std::vector<int> chebyshev(3);
+        std::vector<int> squared(3);
+        std::vector<float> euclidean(3);
+
+        batch.manhattan_distances({1, 1}, manhattan);
+        batch.chebyshev_distances({1, 1}, chebyshev);
+        batch.squared_euclidean_distances({1, 1}, squared);
+        batch.euclidean_distances({1, 1}, euclidean);
+
+        CHECK(manhattan == std::vector{0, 7, 1});
+        CHECK(chebyshev == std::vector{0, 4, 1});
+        CHECK(squared == std::vector{0, 25, 1});
+        CHECK(euclidean[0] == Catch::Approx(0.0f));
+        CHECK(euclidean[1] == Catch::Approx(5.0f));
+        CHECK(euclidean[2] == Catch::Approx(1.0f));
+    }
+
+    SECTION("to_indices()")
+    {
+        const CoordsBatchType batch{{0, 0}, {3, 2}, {1, 1}};
+        std::vector<int> indices(3);
+
+        batch.to_indices(4, indices);
+        CHECK(indices == std::vector{0, 11, 5});
+    }
+}
+
+TEST_CASE("CoordsBatch")
+{
+    SECTION("int8_t") { check_coords_batch<CoordsBatch<int8_t>>(); }
+    SECTION("int16_t") { check_coords_batch<CoordsBatch<int16_t>>(); }
+    SECTION("int32_t") { check_coords_batch<CoordsBatch<int32_t>>(); }
+    SECTION("uint8_t") { check_coords_batch<CoordsBatch<uint8_t>>(); }
+    SECTION("uint16_t") { check_coords_batch<CoordsBatch<uint16_t>>(); }
+}
@@ -0,0 +1,52 @@
+#include <cstdint>
+#include <unordered_set>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../coords_hash.hpp"
+
+template <typename CoordsType>
+void check_coords_hash()
+{
+    using coordinates_type = typename CoordsType::coordinates_type;
+    const std::hash<CoordsType> hash;
+
+    SECTION("equal coordinates have equal hashes")
+    {
+        CHECK(hash(CoordsType{3, 4}) == hash(CoordsType{3, 4}));
+    }
+
+    SECTION("swapped coordinates have different hashes")
+    {
+        CHECK(hash(CoordsType{3, 4}) != hash(CoordsType{4, 3}));
+    }
+
+    SECTION("neighboring coordinates spread over the low bits")
+    {
+        std::unordered_set<std::size_t> low_bits;
+
+        for (int y = 0; y < 16; ++y)
+            for (int x = 0; x < 16; ++x)
+                low_bits.insert(hash(CoordsType{static_cast<coordinates_type>(x), static_cast<coordinates_type>(y)}) & 0x3ff);
+
+        // 256 keys into 1024 buckets, a poor hash (like x ^ y) would only hit a few of them
+        CHECK(low_bits.size() > 200);
+    }
+
+    SECTION("can be used with std::unordered_set")
+    {
+        const std::unordered_set<CoordsType> set{{1, 2}, {2, 1}, {1, 2}};
+
+        CHECK(set.size() == 2);
+        CHECK(set.contains(CoordsType{2, 1}));
+    }
+}
+
+TEST_CASE("std::hash<Coords>")
+{
+    SECTION("int8_t") { check_coords_hash<Coords<int8_t>>(); }
+    SECTION("int16_t") { check_coords_hash<Coords<int16_t>>(); }
+    SECTION("int32_t") { check_coords_hash<Coords<int32_t>>(); }
+    SECTION("uint8_t") { check_coords_hash<Coords<uint8_t>>(); }
+    SECTION("uint16_t") { check_coords_hash<Coords<uint16_t>>(); }
+}
@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../coords_map.hpp"
+#include "../packed_coords.hpp"
+
+// copying and moving throws once copies_until_throw reaches 0, the move constructor is not noexcept
+struct ThrowingCopy {
+    static inline int copies_until_throw = -1;
+
+    int value;
+
+    explicit ThrowingCopy(const int v) : value{v} { }
+    ThrowingCopy(const ThrowingCopy& other) : value{other.value} { count_copy(); }
+    ThrowingCopy(ThrowingCopy&& other) : value{std::exchange(other.value, -1)} { count_copy(); }
+
+    static void count_copy()
+    {
+        if (copies_until_throw >= 0 && copies_until_throw-- == 0)
+            throw std::runtime_error{"copy"};
+    }
+};
+
+TEST_CASE("CoordsMap")
+{
+    SECTION("is empty on creation")
+    {
+        const CoordsMap<Coords<int>, int> map;
+
+        CHECK(map.empty());
+        CHECK(map.size() == 0);
+        CHECK(map.capacity() == 0);
+        CHECK(map.begin() == map.end());
+        CHECK(!map.contains({0, 0}));
+    }
+
+    SECTION("insert() and find()")
+    {
+        CoordsMap<Coords<int>, int> map;
+
+        CHECK(map.insert({{1, 2}, 12}).second);
+        CHECK(map.insert({{2, 1}, 21}).second);
+        CHECK(!map.insert({{1, 2}, 99}).second);
+
+        CHECK(map.size() == 2);
+        CHECK(map.capacity() == CoordsMap<Coords<int>, int>::group_size);
+        CHECK(map.find({1, 2})->second == 12);
+        CHECK(map.find({2, 1})->second == 21);
+        CHECK(map.find({3, 3}) == map.end());
+        CHECK(map.count({1, 2}) == 1);
+        CHECK(map.count({3, 3}) == 0);
+    }
+
+    SECTION("operator[], at() and insert_or_assign()")
+    {
+        CoordsMap<Coords<int>, std::string> map{{{0, 0}, "a"}};
+
+        map[{1, 1}] = "b";
+        map[{0, 0}] += "c";
+
+        CHECK(map.at({0, 0}) == "ac");
+        CHECK(map.at({1, 1}) == "b");
+        CHECK_THROWS_AS(map.at({2, 2}), std::out_of_range);
+
+        CHECK(!map.insert_or_assign({1, 1}, "d").second);
+        CHECK(map.insert_or_assign({2, 2}, "e").second);
+        CHECK(std::as_const(map).at({1, 1}) == "d");
+        CHECK(map.size() == 3);
+    }
+
+    SECTION("try_emplace() does not touch existing entries")
+    {
+        CoordsMap<Coords<int>, std::unique_ptr<int>> map;
+
+        CHECK(map.try_emplace({1, 1}, std::make_unique<int>(1)).second);
+        CHECK(!map.try_emplace({1, 1}, std::make_unique<int>(2)).second);
+        CHECK(*map.at({1, 1}) == 1);
+    }
+
+    SECTION("grows and keeps all entries")
+    {
+        CoordsMap<Coords<int>, int> map;
+
+        for (int y = 0; y < 100; ++y)
+            for (int x = 0; x < 100; ++x)
+                map[{x, y}] = y * 100 + x;
+
+        CHECK(map.size() == 10000);
+        CHECK(map.capacity() >= 10000 + 10000 / 8);
+
+        bool all_found = true;
+
+        for (int y = 0; y < 100; ++y)
+            for (int x = 0; x < 100; ++x)
+                all_found = all_found && map.contains({x, y}) && map.at({x, y}) == y * 100 + x;
+
+        CHECK(all_found);
+        CHECK(static_cast<std::size_t>(std::distance(map.begin(), map.end())) == map.size());
+    }
+
+    SECTION("a throwing copy while growing leaves all entries in place")
+    {
+        CoordsMap<Coords<int>, ThrowingCopy> map;
+
+        for (int i = 0; i < 14; ++i)
+            map.try_emplace({i, i}, i);
+
+        REQUIRE(map.capacity() == 16);
+
+        ThrowingCopy::copies_until_throw = 3;
+        CHECK_THROWS_AS(map.try_emplace({14, 14}, 14), std::runtime_error);
+        ThrowingCopy::copies_until_throw = -1;
+
+        bool all_found = true;
+
+        for (int i = 0; i < 14; ++i)
+            all_found = all_found && map.contains({i, i}) && map.at({i, i}).value == i;
+
+        CHECK(map.size() == 14);
+        CHECK(map.capacity() == 16);
+        CHECK(all_found);
+    }
+
+    SECTION("reserve() allocates up front")
+    {
+        CoordsMap<Coords<int>, int> map(1000);
+        const auto capacity = map.capacity();
+
+        for (int i = 0; i < 1000; ++i)
+            map[{i, -i}] = i;
+
+        CHECK(map.capacity() == capacity);
+    }
+
+    SECTION("erase()")
+    {
+        CoordsMap<Coords<int>, int> map;
+
+        for (int i = 0; i < 100; ++i)
+            map[{i, i}] = i;
+
+        CHECK(map.erase({5, 5}) == 1);
+        CHECK(map.erase({5, 5}) == 0);
+        CHECK(map.size() == 99);
+        CHECK(!map.contains({5, 5}));
+
+        for (auto it = map.begin(); it != map.end();) {
+            if (it->second % 2 == 0)
+                it = map.erase(it);
+            else
+                ++it;
+        }
+
+        CHECK(map.size() == 49);
+        CHECK(std::all_of(map.begin(), map.end(), [](const auto& entry) { return entry.second % 2 == 1; }));
+    }
+
+    SECTION("behaves like std::map under random inserts and erases")
+    {
+        CoordsMap<Coords<short>, int> map;
+        std::map<Coords<short>, int> reference;
+        std::mt19937 gen{7};
+        std::uniform_int_distribution<int> coord{-20, 20};
+
+        for (int i = 0; i < 20000; ++i) {
+            const Coords<short> key{static_cast<short>(coord(gen)), static_cast<short>(coord(gen))};
+
+            if (i % 3 == 0) {
+                CHECK(map.erase(key) == reference.erase(key));
+            } else {
+                map[key] = i;
+                reference[key] = i;
+            }
+        }
+
+        CHECK(map.size() == reference.size());
+
+        bool all_equal = true;
+
+        for (const auto& [key, value] : reference)
+            all_equal = all_equal && map.contains(key) && map.at(key) == value;
+
+        CHECK(all_equal);
+    }
+
+    SECTION("copy, move and clear")
+    {
+        CoordsMap<Coords<int>, std::string> map{{{1, 1}, "a"}, {{2, 2}, "b"}};
+
+        CoordsMap<Coords<int>, std::string> copy{map};
+        CoordsMap<Coords<int>, std::string> moved{std::move(map)};
+
+        CHECK(copy.size() == 2);
+        CHECK(copy.at({2, 2}) == "b");
+        CHECK(moved.size() == 2);
+        CHECK(moved.at({1, 1}) == "a");
+
+        copy.clear();
+        CHECK(copy.empty());
+        CHECK(!copy.contains({1, 1}));
+
+        copy = moved;
+        CHECK(copy.at({1, 1}) == "a");
+    }
+}
+
+TEST_CASE("CoordsSet")
+{
+    SECTION("insert(), contains() and erase()")
+    {
+        CoordsSet<Coords<int>> set{{1, 2}, {3, 4}};
+
+        CHECK(set.insert({5, 6}).second);
+        CHECK(!set.insert({1, 2}).second);
+        CHECK(set.size() == 3);
+        CHECK(set.contains({3, 4}));
+        CHECK(*set.find({3, 4}) == Coords{3, 4});
+
+        CHECK(set.erase({3, 4}) == 1);
+        CHECK(!set.contains({3, 4}));
+
+        std::vector<Coords<int>> values(set.begin(), set.end());
+        std::sort(values.begin(), values.end());
+        CHECK(values == std::vector<Coords<int>>{{1, 2}, {5, 6}});
+    }
+
+    SECTION("works with PackedCoords")
+    {
+        CoordsSet<PackedCoords<int16_t>> visited;
+
+        for (int i = 0; i < 1000; ++i)
+            visited.insert({static_cast<int16_t>(i % 50), static_cast<int16_t>(i / 50)});
+
+        CHECK(visited.size() == 1000);
+        CHECK(visited.contains({49, 19}));
+        CHECK(!visited.contains({50, 19}));
+    }
+}
@@ -1,4 +1,10 @@
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <numeric>
+#include <vector>
 
 #include "catch2/catch_approx.hpp"
 #include "catch2/catch_test_macros.hpp"
@@ -6,6 +12,7 @@
 #include "fmt/core.h"
 #include "fmt/format.h"
 
+#include "../aligned_allocator.hpp"
 #include "../grid.hpp"
 
 Grid<int> create_grid_with_test_values(const int cols, const int rows)
@@ -752,6 +759,31 @@ TEST_CASE("Grid")
         CHECK(grid_with_8_bit_coords.at({255, 255}) == 42);
     }
 
+    SECTION("can create Grid with a custom allocator")
+    {
+        const Grid<int, Coords<int>, AlignedAllocator<int, 64>> grid{4, 3, 42};
+
+        CHECK(reinterpret_cast<std::uintptr_t>(grid.data()) % 64 == 0);
+        CHECK(std::all_of(grid.begin(), grid.end(), [](int i) { return i == 42; }));
+        CHECK(grid.cell(1, 2).value() == 42);
+    }
+
+    SECTION("can create PmrGrid in a memory resource")
+    {
+        std::array<std::byte, 1024> buffer{};
+        std::pmr::monotonic_buffer_resource resource{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+
+        PmrGrid<int> grid1{4, 3, &resource};
+        PmrGrid<int> grid2{4, 3, 7, &resource};
+        grid1.at(3, 2) = 5;
+
+        CHECK(grid1.get_allocator().resource() == &resource);
+        CHECK(grid1.at(3, 2) == 5);
+        CHECK(std::all_of(grid2.begin(), grid2.end(), [](int i) { return i == 7; }));
+        CHECK(reinterpret_cast<const std::byte*>(grid1.data()) >= buffer.data());
+        CHECK(reinterpret_cast<const std::byte*>(grid2.data() + grid2.size()) <= buffer.data() + buffer.size());
+    }
+
     SECTION("width() and height() return the correct values")
     {
         const Grid<int> grid{4, 3};
@@ -844,6 +876,44 @@ TEST_CASE("Grid")
         }
     }
 
+    SECTION("gather() reads values at many coordinates")
+    {
+        const Grid<int> grid = create_grid_with_test_values(4, 3);
+
+        const std::vector<Coords<int>> coords{{0, 0}, {3, 2}, {1, 1}, {4, 0}, {2, 0}, {-1, 1}, {0, 2}, {3, 0}, {1, 3}, {2, 1}, {0, 1}};
+        std::vector<int> values(coords.size(), -1);
+        bool in_bounds[11]{};
+
+        CHECK(grid.gather(coords, values, in_bounds) == 3);
+        CHECK(values == std::vector{11, 34, 22, -1, 13, -1, 31, 14, -1, 23, 21});
+        CHECK(std::vector<bool>(std::begin(in_bounds), std::end(in_bounds)) == std::vector<bool>{true, true, true, false, true, false, true, true, false, true, true});
+    }
+
+    SECTION("gather() works with small Coords types")
+    {
+        const Grid<int, Coords<int8_t>> grid{4, 3, 7};
+        const std::vector<Coords<int8_t>> coords{{0, 0}, {3, 2}, {-1, 0}};
+        std::vector<int> values(coords.size());
+
+        CHECK(grid.gather(coords, values) == 1);
+        CHECK(values == std::vector{7, 7, 0});
+    }
+
+    SECTION("scatter() writes values to many coordinates")
+    {
+        Grid<int> grid{4, 3};
+
+        const std::vector<Coords<int>> coords{{0, 0}, {3, 2}, {1, 1}, {4, 0}, {2, 0}, {-1, 1}, {0, 2}, {3, 0}, {1, 3}, {2, 1}, {0, 1}};
+        std::vector<int> values(coords.size());
+        std::iota(values.begin(), values.end(), 1);
+        bool in_bounds[11]{};
+
+        CHECK(grid.scatter(coords, values, in_bounds) == 3);
+        CHECK(std::vector(grid.begin(), grid.end()) == std::vector{1, 0, 5, 8, 11, 3, 10, 0, 7, 0, 0, 2});
+        CHECK(in_bounds[3] == false);
+        CHECK(in_bounds[10] == true);
+    }
+
     SECTION("row() returns a Row")
     {
         SECTION("const")
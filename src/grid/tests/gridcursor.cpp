@@ -0,0 +1,110 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "../grid.hpp"
+
+Grid<int> create_grid_with_test_values(int cols, int rows);
+
+TEST_CASE("GridCursor")
+{
+    SECTION("can access and change values")
+    {
+        SECTION("const")
+        {
+            const Grid<int> grid = create_grid_with_test_values(4, 5);
+            auto cursor = grid.cursor(2, 1);
+
+            CHECK(cursor.value() == 23);
+            CHECK(cursor.index() == 6);
+            CHECK(cursor.coords() == Coords{2, 1});
+        }
+
+        SECTION("non-const")
+        {
+            Grid<int> grid = create_grid_with_test_values(4, 5);
+
+            auto cursor1 = grid.cursor(2, 1);
+            auto cursor2 = grid.cursor(Coords{3, 2});
+
+            cursor1.value() = 100;
+            cursor2.value() = 200;
+
+            CHECK(grid.at(2, 1) == 100);
+            CHECK(grid.at(3, 2) == 200);
+        }
+    }
+
+    SECTION("can move cursor")
+    {
+        SECTION("const")
+        {
+            const Grid<int> grid = create_grid_with_test_values(4, 5);
+            auto cursor = grid.cursor(1, 2);
+
+            cursor.move_up(2);
+            CHECK(cursor.value() == 12);
+            CHECK(cursor.coords() == Coords{1, 0});
+
+            cursor.move_horizontally(2);
+            CHECK(cursor.value() == 14);
+
+            cursor.move(-2, 3);
+            CHECK(cursor.value() == 42);
+
+            cursor.move(Coords{1, 1});
+            CHECK(cursor.value() == 53);
+            CHECK(cursor.index() == 18);
+        }
+
+        SECTION("non-const")
+        {
+            Grid<int> grid = create_grid_with_test_values(4, 5);
+            auto cursor = grid.cursor(1, 2);
+
+            cursor.move_north(2);
+            cursor.value() = 111;
+            CHECK(grid.at(1, 0) == 111);
+
+            cursor.move_east(2);
+            cursor.value() = 222;
+            CHECK(grid.at(3, 0) == 222);
+
+            cursor.move_south(4);
+            cursor.move_west(3);
+            cursor.value() = 333;
+            CHECK(grid.at(0, 4) == 333);
+
+            cursor.move_right();
+            cursor.move_up();
+            cursor.move_left(0);
+            cursor.move_down(0);
+            cursor.value() = 444;
+            CHECK(grid.at(1, 3) == 444);
+        }
+    }
+
+    SECTION("visits the same values as GridCell")
+    {
+        const Grid<int> grid = create_grid_with_test_values(4, 5);
+        auto cell = grid.cell(0, 0);
+        auto cursor = grid.cursor(0, 0);
+
+        for (int i = 0; i < 3; ++i) {
+            cell.move(1, 1);
+            cursor.move(1, 1);
+            CHECK(cursor.value() == cell.value());
+            CHECK(cursor.coords() == cell);
+        }
+    }
+
+    SECTION("can be used as Coords")
+    {
+        const Grid<int> grid = create_grid_with_test_values(4, 5);
+        const auto cursor = grid.cursor(3, 4);
+
+        CHECK(grid.at(cursor) == 54);
+        CHECK(cursor.col() == 3);
+        CHECK(cursor.row() == 4);
+        CHECK(cursor.neighbors4().size() == 2);
+        CHECK(grid.cursor(0, 4) < cursor);
+    }
+}
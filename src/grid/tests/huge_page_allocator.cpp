@@ -0,0 +1,55 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../grid.hpp"
+#include "../huge_page_allocator.hpp"
+
+TEST_CASE("HugePageAllocator")
+{
+    SECTION("allocates memory aligned to huge pages")
+    {
+        HugePageAllocator<int> allocator;
+
+        for (const std::size_t n : {std::size_t{2}, std::size_t{1000}, HugePageAllocator<int>::huge_page_size / sizeof(int) + 1}) {
+            int* p = allocator.allocate(n);
+            CHECK(reinterpret_cast<std::uintptr_t>(p) % HugePageAllocator<int>::huge_page_size == 0);
+
+            p[0] = 1;
+            p[n - 1] = 2;
+            CHECK(p[0] + p[n - 1] == 3);
+
+            allocator.deallocate(p, n);
+        }
+    }
+
+    SECTION("rejects sizes whose mapping size would overflow")
+    {
+        HugePageAllocator<int> allocator;
+
+        CHECK(std::allocator_traits<HugePageAllocator<int>>::max_size(allocator) == HugePageAllocator<int>::max_size());
+        CHECK_THROWS_AS(static_cast<void>(allocator.allocate(HugePageAllocator<int>::max_size() + 1)), std::bad_array_new_length);
+        CHECK_THROWS_AS(static_cast<void>(allocator.allocate(std::numeric_limits<std::size_t>::max())), std::bad_array_new_length);
+    }
+
+    SECTION("can be used with Grid")
+    {
+        Grid<int, Coords<int>, HugePageAllocator<int>> grid{1024, 1024, 42};
+        grid.at(1023, 1023) = 1;
+
+        CHECK(reinterpret_cast<std::uintptr_t>(grid.data()) % HugePageAllocator<int>::huge_page_size == 0);
+        CHECK(std::count(grid.begin(), grid.end(), 42) == 1024 * 1024 - 1);
+        CHECK(grid.at(1023, 1023) == 1);
+    }
+
+    SECTION("all instances compare equal")
+    {
+        CHECK(HugePageAllocator<int>{} == HugePageAllocator<int>{});
+        CHECK(HugePageAllocator<int>{} == HugePageAllocator<double>{});
+    }
+}
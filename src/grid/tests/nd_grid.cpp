@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../nd_grid.hpp"
+
+template <typename NdGridType>
+void fill_with_test_values(NdGridType& grid)
+{
+    // 3D: (z + 1) * 100 + (y + 1) * 10 + x + 1
+    grid.for_each_indexed([](const auto& indices, int& value) {
+        value = 0;
+
+        for (std::size_t dim = indices.size(); dim-- > 0;)
+            value = value * 10 + indices[dim] + 1;
+    });
+}
+
+TEST_CASE("NdGrid")
+{
+    SECTION("dynamic extents")
+    {
+        const NdGrid<int, 3> grid{4, 3, 2};
+
+        CHECK(grid.rank() == 3);
+        CHECK(grid.rank_dynamic() == 3);
+        CHECK(grid.extent(0) == 4);
+        CHECK(grid.extent<1>() == 3);
+        CHECK(grid.extent<2>() == 2);
+        CHECK(grid.stride<0>() == 1);
+        CHECK(grid.stride<1>() == 4);
+        CHECK(grid.stride<2>() == 12);
+        CHECK(grid.size() == 24);
+        CHECK(std::all_of(grid.begin(), grid.end(), [](int i) { return i == 0; }));
+    }
+
+    SECTION("static extents")
+    {
+        const NdGrid<int, 2, 8, 4> grid;
+
+        static_assert(NdGrid<int, 2, 8, 4>::rank_dynamic() == 0);
+
+        CHECK(grid.extent<0>() == 8);
+        CHECK(grid.extent<1>() == 4);
+        CHECK(grid.stride<1>() == 8);
+        CHECK(grid.size() == 32);
+    }
+
+    SECTION("mixed static and dynamic extents")
+    {
+        const NdGrid<int, 3, 4, dynamic_extent, 2> grid{std::array{3}, 7};
+
+        CHECK(grid.rank_dynamic() == 1);
+        CHECK(grid.static_extent(1) == dynamic_extent);
+        CHECK(grid.extent(1) == 3);
+        CHECK(grid.stride<2>() == 12);
+        CHECK(std::all_of(grid.begin(), grid.end(), [](int i) { return i == 7; }));
+    }
+
+    SECTION("element access")
+    {
+        NdGrid<int, 3> grid{4, 3, 2};
+        fill_with_test_values(grid);
+
+        CHECK(grid(0, 0, 0) == 111);
+        CHECK(grid(3, 2, 1) == 234);
+        CHECK(grid.at({1, 2, 0}) == 132);
+        CHECK(grid.data()[1] == 112);
+        CHECK(grid.data()[4] == 121);
+        CHECK(grid.data()[12] == 211);
+
+        grid(2, 1, 1) = 0;
+        CHECK(grid.at({2, 1, 1}) == 0);
+    }
+
+    SECTION("for_each_indexed() visits in memory order")
+    {
+        NdGrid<int, 3, 3, 2, 2> grid;
+        std::vector<std::array<int, 3>> visited;
+
+        grid.for_each_indexed([&](const auto& indices, int&) { visited.push_back(indices); });
+
+        CHECK(visited.size() == 12);
+        CHECK(visited[0] == std::array{0, 0, 0});
+        CHECK(visited[1] == std::array{1, 0, 0});
+        CHECK(visited[3] == std::array{0, 1, 0});
+        CHECK(visited[11] == std::array{2, 1, 1});
+    }
+
+    SECTION("slices")
+    {
+        NdGrid<int, 3> grid{4, 3, 2};
+        fill_with_test_values(grid);
+
+        const auto z_slice = grid.slice<2>(1);
+        CHECK(z_slice.rank() == 2);
+        CHECK(z_slice.extent(0) == 4);
+        CHECK(z_slice.extent(1) == 3);
+        CHECK(z_slice(2, 1) == 223);
+
+        const auto y_slice = grid.slice<1>(2);
+        CHECK(y_slice.extent(0) == 4);
+        CHECK(y_slice.extent(1) == 2);
+        CHECK(y_slice(3, 1) == 234);
+
+        const auto x_slice = std::as_const(grid).slice<0>(0);
+        CHECK(x_slice(2, 1) == 231);
+        CHECK(x_slice.size() == 6);
+
+        const auto line = y_slice.slice<1>(0);
+        CHECK(line.rank() == 1);
+        CHECK(line(3) == 134);
+
+        std::vector<int> values;
+        x_slice.for_each([&](int value) { values.push_back(value); });
+        CHECK(values == std::vector{111, 121, 131, 211, 221, 231});
+
+        grid.slice<2>(0)(0, 0) = 0;
+        CHECK(grid(0, 0, 0) == 0);
+    }
+
+    SECTION("lines")
+    {
+        NdGrid<int, 3> grid{4, 3, 2};
+        fill_with_test_values(grid);
+
+        const auto x_line = grid.line<0>({0, 1, 1});
+        const auto y_line = grid.line<1>({2, 0, 0});
+        const auto z_line = std::as_const(grid).line<2>({3, 2, 1});
+
+        CHECK(std::vector(x_line.begin(), x_line.end()) == std::vector{221, 222, 223, 224});
+        CHECK(std::vector(y_line.begin(), y_line.end()) == std::vector{113, 123, 133});
+        CHECK(std::vector(z_line.begin(), z_line.end()) == std::vector{134, 234});
+        CHECK(z_line.size() == 2);
+        CHECK(z_line[1] == 234);
+
+        y_line[1] = 0;
+        CHECK(grid(2, 1, 0) == 0);
+    }
+
+    SECTION("rank 1 and rank 4")
+    {
+        NdGrid<int, 1> line{5};
+        std::iota(line.begin(), line.end(), 0);
+        CHECK(line(3) == 3);
+
+        NdGrid<int, 4, 2, 2, 2, 2> tesseract;
+        std::iota(tesseract.begin(), tesseract.end(), 0);
+        CHECK(tesseract(1, 1, 1, 1) == 15);
+        CHECK(tesseract(0, 0, 0, 1) == 8);
+        CHECK(tesseract.slice<3>(1).slice<2>(1)(1, 0) == 13);
+    }
+}
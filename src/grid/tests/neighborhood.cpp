@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../coords3.hpp"
+#include "../grid.hpp"
+
+Grid<int> create_grid_with_test_values(int cols, int rows);
+
+template <typename Range>
+std::vector<int> values(const Range& range)
+{
+    std::vector<int> result;
+
+    for (const auto value : range)
+        result.push_back(value);
+
+    return result;
+}
+
+template <typename Cell>
+concept HasNeighbors = requires(const Cell& cell) {
+    cell.neighbors4();
+    cell.neighbors8();
+    cell.template neighborhood<2>();
+};
+
+TEST_CASE("Neighborhood")
+{
+    const Grid<int> grid = create_grid_with_test_values(5, 4);
+
+    SECTION("neighbors4() returns the orthogonal neighbors in memory order")
+    {
+        CHECK(values(grid.cell(2, 1).neighbors4()) == std::vector{13, 22, 24, 33});
+    }
+
+    SECTION("neighbors8() returns all adjacent neighbors in memory order")
+    {
+        CHECK(values(grid.cell(2, 1).neighbors8()) == std::vector{12, 13, 14, 22, 24, 32, 33, 34});
+    }
+
+    SECTION("neighborhood<R>() returns all neighbors within radius R")
+    {
+        const auto neighborhood = grid.cell(2, 2).neighborhood<2>();
+        const auto sum = std::accumulate(neighborhood.begin(), neighborhood.end(), 0);
+
+        CHECK(neighborhood.size() == 19);
+        CHECK(sum == std::accumulate(grid.begin(), grid.end(), 0) - 33);
+    }
+
+    SECTION("skip neighbors outside of the grid")
+    {
+        CHECK(values(grid.cell(0, 0).neighbors4()) == std::vector{12, 21});
+        CHECK(values(grid.cell(4, 3).neighbors8(BorderMode::skip)) == std::vector{34, 35, 44});
+        CHECK(grid.cell(0, 0).neighborhood<2>().size() == 8);
+    }
+
+    SECTION("clamp neighbors outside of the grid to the border")
+    {
+        CHECK(values(grid.cell(0, 0).neighbors4(BorderMode::clamp)) == std::vector{11, 11, 12, 21});
+        CHECK(values(grid.cell(4, 3).neighbors8(BorderMode::clamp)) == std::vector{34, 35, 35, 44, 45, 44, 45, 45});
+    }
+
+    SECTION("wrap neighbors outside of the grid around")
+    {
+        CHECK(values(grid.cell(0, 0).neighbors4(BorderMode::wrap)) == std::vector{41, 15, 12, 21});
+        CHECK(values(grid.cell(4, 3).neighbors8(BorderMode::wrap)) == std::vector{34, 35, 31, 44, 41, 14, 15, 11});
+    }
+
+    SECTION("only cells of 2D row-major grids have neighbors")
+    {
+        using PlanarCell = GridCell<const Grid<int>*, Coords<int>>;
+        using SlicedCell = GridCell<const Grid<int>*, Coords3<int>>;
+
+        static_assert(HasNeighbors<PlanarCell>);
+        static_assert(!HasNeighbors<SlicedCell>);
+    }
+
+    SECTION("coords() and cells() return the neighbor coordinates")
+    {
+        const auto neighbors = grid.cell(0, 1).neighbors4();
+
+        REQUIRE(neighbors.size() == 3);
+        CHECK(neighbors.coords(0) == Coords{0, 0});
+        CHECK(neighbors.coords(1) == Coords{1, 1});
+        CHECK(neighbors.coords(2) == Coords{0, 2});
+
+        std::vector<Coords<int>> coords;
+
+        for (auto cell : neighbors.cells())
+            coords.push_back(cell);
+
+        CHECK(coords == std::vector{Coords{0, 0}, Coords{1, 1}, Coords{0, 2}});
+    }
+
+    SECTION("can change values through the neighborhood")
+    {
+        Grid<int> copy = grid;
+
+        for (auto& value : copy.cell(1, 1).neighbors8())
+            value = 0;
+
+        for (auto cell : copy.cell(3, 3).neighbors4().cells())
+            cell.value() = 1;
+
+        CHECK(std::count(copy.begin(), copy.end(), 0) == 8);
+        CHECK(std::count(copy.begin(), copy.end(), 1) == 3);
+        CHECK(copy.at(1, 1) == 22);
+    }
+
+    SECTION("works with algorithms")
+    {
+        const auto neighbors = grid.cell(2, 2).neighbors8();
+
+        CHECK(std::distance(neighbors.begin(), neighbors.end()) == 8);
+        CHECK(*std::max_element(neighbors.begin(), neighbors.end()) == 44);
+        CHECK(std::find(neighbors.begin(), neighbors.end(), 23) - neighbors.begin() == 1);
+    }
+}
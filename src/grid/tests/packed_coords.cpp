@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../grid.hpp"
+#include "../packed_coords.hpp"
+
+template <typename CoordsType>
+void check_packed_coords()
+{
+    using coordinates_type = typename CoordsType::coordinates_type;
+    using packed_coordinates_type = typename CoordsType::packed_coordinates_type;
+
+    SECTION("creation")
+    {
+        CHECK(CoordsType{}.col() == 0);
+        CHECK(CoordsType{}.row() == 0);
+        CHECK(CoordsType{2, 3}.col() == 2);
+        CHECK(CoordsType{2, 3}.row() == 3);
+        CHECK(CoordsType::from_packed(CoordsType{2, 3}.packed()) == CoordsType{2, 3});
+    }
+
+    SECTION("stores both coordinates in one integer")
+    {
+        CHECK(sizeof(CoordsType) == 2 * sizeof(packed_coordinates_type));
+        CHECK(sizeof(CoordsType) == sizeof(typename CoordsType::storage_type));
+    }
+
+    SECTION("arithmetic")
+    {
+        CoordsType a{4, 5};
+        CoordsType b{4, 5};
+
+        a += CoordsType{2, 1};
+        b -= CoordsType{1, 2};
+
+        CHECK(a == CoordsType{6, 6});
+        CHECK(b == CoordsType{3, 3});
+        CHECK(CoordsType{4, 5} + CoordsType{2, 1} == CoordsType{6, 6});
+        CHECK(CoordsType{4, 5} - CoordsType{1, 2} == CoordsType{3, 3});
+        CHECK(CoordsType{4, 0} - CoordsType{0, 1} == CoordsType{4, static_cast<packed_coordinates_type>(-1)});
+    }
+
+    SECTION("comparison orders by x first, then y, like Coords")
+    {
+        CHECK(CoordsType{2, 3} == CoordsType{2, 3});
+        CHECK(CoordsType{2, 3} != CoordsType{3, 2});
+
+        CHECK(CoordsType{2, 2} < CoordsType{3, 3});
+        CHECK(CoordsType{2, 3} < CoordsType{3, 2});
+        CHECK(CoordsType{3, 2} < CoordsType{3, 3});
+        CHECK((CoordsType{2, 2} < CoordsType{2, 2}) == false);
+        CHECK(CoordsType{3, 3} > CoordsType{2, 3});
+        CHECK(CoordsType{2, 2} <= CoordsType{2, 2});
+        CHECK(CoordsType{3, 3} >= CoordsType{3, 2});
+
+        if constexpr (std::is_signed_v<coordinates_type>) {
+            CHECK(CoordsType{-1, 5} < CoordsType{0, 0});
+            CHECK(CoordsType{0, -1} < CoordsType{0, 0});
+            CHECK(CoordsType{std::numeric_limits<packed_coordinates_type>::min(), 0} < CoordsType{std::numeric_limits<packed_coordinates_type>::max(), 0});
+        }
+    }
+
+    SECTION("move")
+    {
+        CoordsType a{10, 10};
+        CoordsType b{a};
+
+        a.move(2, 1);
+        b.move(CoordsType{2, 1});
+
+        CHECK(a == CoordsType{12, 11});
+        CHECK(b == CoordsType{12, 11});
+
+        a.move(-6, -9);
+        CHECK(a == CoordsType{6, 2});
+
+        if constexpr (std::is_signed_v<coordinates_type>) {
+            b.move(CoordsType{-6, -9});
+            CHECK(b == CoordsType{6, 2});
+
+            b.move(-8, -5);
+            CHECK(b == CoordsType{-2, -3});
+        }
+    }
+
+    SECTION("move in relative and cardinal directions")
+    {
+        CoordsType a{10, 10};
+
+        a.move_up(3);
+        CHECK(a == CoordsType{10, 7});
+        a.move_down(5);
+        CHECK(a == CoordsType{10, 12});
+        a.move_right(5);
+        CHECK(a == CoordsType{15, 12});
+        a.move_left(8);
+        CHECK(a == CoordsType{7, 12});
+
+        a.move_north(2);
+        CHECK(a == CoordsType{7, 10});
+        a.move_south(-2);
+        CHECK(a == CoordsType{7, 8});
+        a.move_east(1);
+        CHECK(a == CoordsType{8, 8});
+        a.move_west(3);
+        CHECK(a == CoordsType{5, 8});
+    }
+
+    SECTION("moving wraps around inside each coordinate without touching the other")
+    {
+        constexpr auto max = std::numeric_limits<packed_coordinates_type>::max();
+
+        CoordsType a{0, max};
+        a.move(max, 0);
+        CHECK(a == CoordsType{max, max});
+
+        a.move_vertically(1);
+        CHECK(a.col() == max);
+        CHECK(a.row() == std::numeric_limits<packed_coordinates_type>::min());
+
+        a.move_vertically(-1);
+        CHECK(a == CoordsType{max, max});
+    }
+
+    SECTION("hash")
+    {
+        std::unordered_set<CoordsType> set;
+
+        for (int y = 0; y < 10; ++y)
+            for (int x = 0; x < 10; ++x)
+                set.insert(CoordsType{static_cast<coordinates_type>(x), static_cast<coordinates_type>(y)});
+
+        CHECK(set.size() == 100);
+        CHECK(set.contains(CoordsType{3, 7}));
+        CHECK(!set.contains(CoordsType{10, 7}));
+        CHECK(std::hash<CoordsType>{}(CoordsType{1, 2}) != std::hash<CoordsType>{}(CoordsType{2, 1}));
+    }
+}
+
+TEST_CASE("PackedCoords")
+{
+    SECTION("int8_t") { check_packed_coords<PackedCoords<int8_t>>(); }
+    SECTION("int16_t") { check_packed_coords<PackedCoords<int16_t>>(); }
+    SECTION("int32_t") { check_packed_coords<PackedCoords<int32_t>>(); }
+    SECTION("uint8_t") { check_packed_coords<PackedCoords<uint8_t>>(); }
+    SECTION("uint16_t") { check_packed_coords<PackedCoords<uint16_t>>(); }
+    SECTION("int32_t packed into int16_t") { check_packed_coords<PackedCoords<int32_t, int16_t>>(); }
+    SECTION("int16_t packed into int8_t") { check_packed_coords<PackedCoords<int16_t, int8_t>>(); }
+    SECTION("uint16_t packed into uint8_t") { check_packed_coords<PackedCoords<uint16_t, uint8_t>>(); }
+}
+
+TEST_CASE("PackedCoords with narrower packed coordinates")
+{
+    SECTION("take half the size of Coords")
+    {
+        CHECK(sizeof(PackedCoords<int>) == sizeof(Coords<int>));
+        CHECK(sizeof(PackedCoords<int, int16_t>) == sizeof(Coords<int>) / 2);
+        CHECK(sizeof(PackedCoords<int, int8_t>) == sizeof(Coords<int>) / 4);
+    }
+
+    SECTION("limit the range of the coordinates")
+    {
+        CHECK(PackedCoords<int, int16_t>::max() == std::numeric_limits<int16_t>::max());
+        CHECK(PackedCoords<int, int16_t>{-32768, 32767}.col() == -32768);
+        CHECK(PackedCoords<int, int16_t>{-32768, 32767}.row() == 32767);
+    }
+
+    SECTION("as Grid CoordsType")
+    {
+        Grid<int, PackedCoords<int, int16_t>> grid{4, 3};
+        grid.at(3, 2) = 5;
+
+        CHECK(grid.at(PackedCoords<int, int16_t>{3, 2}) == 5);
+        CHECK(grid.cell(3, 2).value() == 5);
+    }
+}
+
+TEST_CASE("PackedCoords as Grid CoordsType")
+{
+    Grid<int, PackedCoords<int16_t>> grid{4, 3};
+
+    for (int row = 0; row < 3; ++row)
+        for (int col = 0; col < 4; ++col)
+            grid.at(col, row) = (row + 1) * 10 + col + 1;
+
+    SECTION("at()")
+    {
+        CHECK(grid.at(PackedCoords<int16_t>{2, 1}) == 23);
+    }
+
+    SECTION("cell()")
+    {
+        auto cell = grid.cell(2, 1);
+
+        CHECK(cell.col() == 2);
+        CHECK(cell.row() == 1);
+        CHECK(cell.value() == 23);
+
+        cell.move_up();
+        CHECK(cell.value() == 13);
+    }
+
+    SECTION("cursor() and neighbors")
+    {
+        auto cursor = grid.cursor(1, 1);
+        cursor.move_right();
+
+        CHECK(cursor.value() == 23);
+        CHECK(cursor.neighbors4().size() == 4);
+
+        std::vector<int> neighbors(cursor.neighbors4().begin(), cursor.neighbors4().end());
+        std::sort(neighbors.begin(), neighbors.end());
+        CHECK(neighbors == std::vector{13, 22, 24, 33});
+    }
+
+    SECTION("gather()")
+    {
+        const std::vector<PackedCoords<int16_t>> coords{{0, 0}, {3, 2}, {4, 0}};
+        std::vector<int> values(coords.size());
+
+        CHECK(grid.gather(coords, values) == 1);
+        CHECK(values == std::vector{11, 34, 0});
+    }
+
+    SECTION("sort_by_tile()")
+    {
+        std::vector<PackedCoords<int16_t>> coords{{3, 1}, {0, 2}, {1, 0}};
+        sort_by_tile(std::span{coords}, 2);
+
+        CHECK(coords == std::vector<PackedCoords<int16_t>>{{1, 0}, {3, 1}, {0, 2}});
+    }
+}
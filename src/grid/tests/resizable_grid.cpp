@@ -0,0 +1,162 @@
+#include <algorithm>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../resizable_grid.hpp"
+
+Grid<int> create_grid_with_test_values(int cols, int rows);
+
+TEST_CASE("ResizableGrid")
+{
+    SECTION("can create new ResizableGrid with default values")
+    {
+        const ResizableGrid<int> grid{4, 3, -1};
+
+        CHECK(grid.width() == 4);
+        CHECK(grid.height() == 3);
+        CHECK(grid.size() == 12);
+        CHECK(grid.min_col() == 0);
+        CHECK(grid.min_row() == 0);
+        CHECK(grid.max_col() == 3);
+        CHECK(grid.max_row() == 2);
+        CHECK(grid.at(0, 0) == -1);
+        CHECK(grid.at(Coords{3, 2}) == -1);
+    }
+
+    SECTION("can be created from and converted to a Grid")
+    {
+        const Grid<int> grid = create_grid_with_test_values(6, 5);
+        const ResizableGrid<int> resizable_grid{grid};
+
+        CHECK(resizable_grid.at(0, 0) == 11);
+        CHECK(resizable_grid.at(5, 4) == 56);
+
+        const Grid<int> copy = resizable_grid.to_grid();
+
+        CHECK(std::equal(grid.begin(), grid.end(), copy.begin(), copy.end()));
+    }
+
+    SECTION("growing keeps the values at their coordinates")
+    {
+        ResizableGrid<int> grid{create_grid_with_test_values(4, 3)};
+
+        grid.grow_left(2, -1);
+        grid.grow_right(3, -2);
+        grid.grow_up(1, -3);
+        grid.grow_down(2, -4);
+
+        CHECK(grid.width() == 9);
+        CHECK(grid.height() == 6);
+        CHECK(grid.min_col() == -2);
+        CHECK(grid.min_row() == -1);
+        CHECK(grid.max_col() == 6);
+        CHECK(grid.max_row() == 4);
+
+        for (int row = 0; row < 3; ++row)
+            for (int col = 0; col < 4; ++col)
+                CHECK(grid.at(col, row) == (row + 1) * 10 + col + 1);
+
+        CHECK(grid.at(-2, 0) == -1);
+        CHECK(grid.at(-1, 2) == -1);
+        CHECK(grid.at(4, 0) == -2);
+        CHECK(grid.at(6, 2) == -2);
+        CHECK(grid.at(-2, -1) == -3);
+        CHECK(grid.at(6, -1) == -3);
+        CHECK(grid.at(-2, 4) == -4);
+        CHECK(grid.at(6, 3) == -4);
+        CHECK(grid.contains(-2, -1));
+        CHECK(grid.contains(6, 4));
+        CHECK_FALSE(grid.contains(-3, 0));
+        CHECK_FALSE(grid.contains(0, 5));
+    }
+
+    SECTION("growing one column at a time only reallocates when the capacity runs out")
+    {
+        ResizableGrid<int> grid{4, 4};
+        int reallocations = 0;
+
+        for (int i = 0; i < 100; ++i) {
+            const int capacity = grid.capacity_width();
+            grid.grow_right(1, i);
+
+            if (grid.capacity_width() != capacity)
+                ++reallocations;
+
+            CHECK(grid.at(grid.max_col(), 3) == i);
+        }
+
+        CHECK(grid.width() == 104);
+        CHECK(grid.capacity_width() >= 104);
+        CHECK(grid.capacity_height() == 4);
+        CHECK(reallocations <= 7);
+    }
+
+    SECTION("reallocating leaves room on both sides")
+    {
+        ResizableGrid<int> grid{4, 4};
+
+        grid.grow_right(1);
+
+        const int capacity = grid.capacity_width();
+        grid.grow_left(1);
+
+        CHECK(grid.capacity_width() == capacity);
+    }
+
+    SECTION("resize() changes the size at the right and bottom")
+    {
+        ResizableGrid<int> grid{create_grid_with_test_values(4, 3)};
+
+        grid.resize(2, 5, 0);
+
+        CHECK(grid.width() == 2);
+        CHECK(grid.height() == 5);
+        CHECK(grid.at(1, 2) == 32);
+        CHECK(grid.at(0, 3) == 0);
+        CHECK(grid.at(1, 4) == 0);
+
+        // cells that were cut off get the new value when growing again
+        grid.resize(4, 5, 7);
+
+        CHECK(grid.at(3, 0) == 7);
+        CHECK(grid.at(2, 2) == 7);
+        CHECK(grid.at(1, 2) == 32);
+    }
+
+    SECTION("reserve() and shrink_to_fit() change the capacity")
+    {
+        ResizableGrid<int> grid{create_grid_with_test_values(4, 3)};
+
+        grid.reserve(10, 8);
+
+        CHECK(grid.capacity_width() == 10);
+        CHECK(grid.capacity_height() == 8);
+        CHECK(grid.at(3, 2) == 34);
+
+        grid.grow_left(3);
+        grid.grow_up(2);
+
+        CHECK(grid.capacity_width() == 10);
+        CHECK(grid.capacity_height() == 8);
+
+        grid.shrink_to_fit();
+
+        CHECK(grid.capacity_width() == 7);
+        CHECK(grid.capacity_height() == 5);
+        CHECK(grid.at(-3, -2) == 0);
+        CHECK(grid.at(3, 2) == 34);
+    }
+
+    SECTION("row() returns the values of a row")
+    {
+        ResizableGrid<int> grid{create_grid_with_test_values(4, 3)};
+        grid.grow_left(1, 0);
+
+        const auto row = grid.row(1);
+
+        CHECK(row.size() == 5);
+        CHECK(row[0] == 0);
+        CHECK(row[1] == 21);
+        CHECK(row[4] == 24);
+    }
+}
@@ -0,0 +1,82 @@
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "segmented_algorithms.hpp"
+
+#include "../grid.hpp"
+
+Grid<int> create_grid_with_test_values(int cols, int rows);
+
+TEST_CASE("segmented algorithms")
+{
+    auto grid = create_grid_with_test_values(4, 3);
+    const auto& const_grid = grid;
+    const auto col = const_grid.col(1);
+    const auto row = const_grid.row(2);
+
+    SECTION("StridedIterator exposes its pointer and stride")
+    {
+        static_assert(StridedMemoryIterator<decltype(col.begin())>);
+        static_assert(ChunkedMemoryIterator<decltype(grid.begin())>);
+
+        CHECK(col.begin().base() == &grid.at(1, 0));
+        CHECK(col.begin().stride() == grid.width());
+        CHECK(row.begin().stride() == 1);
+    }
+
+    SECTION("segmented_accumulate()")
+    {
+        CHECK(segmented_accumulate(col.begin(), col.end(), 0) == std::accumulate(col.begin(), col.end(), 0));
+        CHECK(segmented_accumulate(row.begin(), row.end(), 0) == std::accumulate(row.begin(), row.end(), 0));
+        CHECK(segmented_accumulate(grid.begin(), grid.end(), 0) == std::accumulate(grid.begin(), grid.end(), 0));
+        CHECK(segmented_accumulate(col.rbegin(), col.rend(), 1, std::multiplies<>{}) == std::accumulate(col.begin(), col.end(), 1, std::multiplies<>{}));
+        CHECK(segmented_accumulate(col.begin(), col.begin(), 5) == 5);
+    }
+
+    SECTION("segmented_for_each()")
+    {
+        std::vector<int> values;
+        segmented_for_each(col.begin(), col.end(), [&](const int value) { values.push_back(value); });
+
+        CHECK(values == std::vector<int>(col.begin(), col.end()));
+    }
+
+    SECTION("segmented_copy() and segmented_transform()")
+    {
+        std::vector<int> values(3);
+
+        CHECK(segmented_copy(col.begin(), col.end(), values.begin()) == values.end());
+        CHECK(values == std::vector<int>(col.begin(), col.end()));
+
+        // from a column into a column, and into an output iterator that is not chunked
+        segmented_transform(col.begin(), col.end(), grid.col(3).begin(), [](const int value) { return -value; });
+
+        for (int y = 0; y < grid.height(); ++y)
+            CHECK(grid.at(3, y) == -grid.at(1, y));
+
+        std::vector<int> appended;
+        segmented_copy(row.begin(), row.end(), std::back_inserter(appended));
+        CHECK(appended == std::vector<int>(row.begin(), row.end()));
+    }
+
+    SECTION("segmented_fill()")
+    {
+        auto target = grid.col(0);
+        segmented_fill(target.begin(), target.end(), 7);
+
+        for (int y = 0; y < grid.height(); ++y) {
+            CHECK(grid.at(0, y) == 7);
+            CHECK(grid.at(1, y) != 7);
+        }
+    }
+
+    SECTION("segmented_find()")
+    {
+        CHECK(segmented_find(col.begin(), col.end(), grid.at(1, 2)) == col.begin() + 2);
+        CHECK(segmented_find(col.begin(), col.end(), -1) == col.end());
+        CHECK(segmented_find(grid.cbegin(), grid.cend(), grid.at(3, 1)) == grid.cbegin() + 7);
+    }
+}
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <utility>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../snapshot_grid.hpp"
+
+Grid<int> create_grid_with_test_values(int cols, int rows);
+
+TEST_CASE("SnapshotGrid")
+{
+    SECTION("can create new SnapshotGrid with default values")
+    {
+        const SnapshotGrid<int, Coords<int>, 4> grid{10, 7, -1};
+
+        CHECK(grid.width() == 10);
+        CHECK(grid.height() == 7);
+        CHECK(grid.size() == 70);
+        CHECK(grid.tiles_width() == 3);
+        CHECK(grid.tiles_height() == 2);
+        CHECK(grid.at(0, 0) == -1);
+        CHECK(grid.at(9, 6) == -1);
+    }
+
+    SECTION("can be created from and converted to a Grid")
+    {
+        const Grid<int> grid = create_grid_with_test_values(6, 5);
+        const SnapshotGrid<int, Coords<int>, 4> snapshot_grid{grid};
+
+        CHECK(snapshot_grid.at(0, 0) == 11);
+        CHECK(snapshot_grid.at(5, 4) == 56);
+        CHECK(snapshot_grid.at(Coords{4, 3}) == 45);
+
+        const Grid<int> copy = snapshot_grid.to_grid();
+
+        CHECK(std::equal(grid.begin(), grid.end(), copy.begin(), copy.end()));
+    }
+
+    SECTION("can use at() to change values")
+    {
+        SnapshotGrid<int, Coords<int>, 4> grid{6, 5};
+
+        grid.at(1, 1) = 100;
+        grid.at(Coords{5, 4}) = 200;
+
+        CHECK(grid.at(1, 1) == 100);
+        CHECK(grid.at(5, 4) == 200);
+        CHECK(grid.at(0, 0) == 0);
+    }
+
+    SECTION("a snapshot shares all tiles until one version gets changed")
+    {
+        SnapshotGrid<int, Coords<int>, 4> grid{create_grid_with_test_values(8, 8)};
+        const auto snapshot = grid.snapshot();
+
+        CHECK(grid.shared_tiles(snapshot) == 4);
+        CHECK(grid.changed_tiles(snapshot).empty());
+
+        grid.at(5, 1) = 100;
+        grid.at(6, 2) = 200;
+
+        CHECK(grid.shared_tiles(snapshot) == 3);
+        CHECK(grid.changed_tiles(snapshot) == std::vector{Coords{1, 0}});
+
+        CHECK(grid.at(5, 1) == 100);
+        CHECK(grid.at(6, 2) == 200);
+        CHECK(snapshot.at(5, 1) == 26);
+        CHECK(snapshot.at(6, 2) == 37);
+    }
+
+    SECTION("can roll back to a snapshot")
+    {
+        SnapshotGrid<int, Coords<int>, 4> grid{8, 8, 1};
+        const auto snapshot = grid.snapshot();
+
+        grid.at(0, 0) = 2;
+        grid.at(7, 7) = 3;
+        REQUIRE(grid.changed_tiles(snapshot).size() == 2);
+
+        grid = snapshot;
+
+        CHECK(std::as_const(grid).at(0, 0) == 1);
+        CHECK(std::as_const(grid).at(7, 7) == 1);
+        CHECK(grid.shared_tiles(snapshot) == 4);
+    }
+
+    SECTION("partial tiles at the borders")
+    {
+        SnapshotGrid<int, Coords<int>, 4> grid{create_grid_with_test_values(5, 6)};
+
+        for (int row = 0; row < grid.height(); ++row)
+            for (int col = 0; col < grid.width(); ++col)
+                CHECK(grid.at(col, row) == (row + 1) * 10 + col + 1);
+    }
+}
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../thread_local_grid.hpp"
+
+TEST_CASE("ThreadLocalGrid")
+{
+    SECTION("allocates only tiles that get touched")
+    {
+        ThreadLocalGrid<int, Coords<int>, 4> grid{10, 10, 2};
+
+        CHECK(grid.width() == 10);
+        CHECK(grid.height() == 10);
+        CHECK(grid.workers() == 2);
+        CHECK(grid.allocated_tiles() == 0);
+
+        auto local0 = grid.local(0);
+        auto local1 = grid.local(1);
+
+        local0.at(0, 0) += 1;
+        local0.at(3, 3) += 1;
+        local1.at(9, 9) += 1;
+
+        CHECK(local0.allocated_tiles() == 1);
+        CHECK(local1.allocated_tiles() == 1);
+        CHECK(grid.allocated_tiles() == 2);
+    }
+
+    SECTION("merge_sum() adds up all workers")
+    {
+        ThreadLocalGrid<int, Coords<int>, 4> grid{10, 7, 5};
+
+        for (int worker = 0; worker < grid.workers(); ++worker) {
+            auto local = grid.local(worker);
+            local.at(0, 0) += 1;
+            local.at(Coords{9, 6}) += worker;
+            local.at(worker, worker) += 10;
+        }
+
+        const Grid<int> sum = grid.merge_sum();
+
+        CHECK(sum.at(0, 0) == 5 + 10);
+        CHECK(sum.at(9, 6) == 0 + 1 + 2 + 3 + 4);
+        CHECK(sum.at(1, 1) == 10);
+        CHECK(sum.at(4, 4) == 10);
+        CHECK(sum.at(5, 5) == 0);
+        CHECK(std::accumulate(sum.begin(), sum.end(), 0) == 5 + 10 + 50);
+        CHECK(grid.allocated_tiles() == 0);
+    }
+
+    SECTION("merge_min() and merge_max() with matching identity values")
+    {
+        ThreadLocalGrid<int, Coords<int>, 4> min_grid{6, 6, 3, std::numeric_limits<int>::max()};
+        ThreadLocalGrid<int, Coords<int>, 4> max_grid{6, 6, 3, std::numeric_limits<int>::min()};
+
+        for (int worker = 0; worker < 3; ++worker) {
+            min_grid.local(worker).at(2, 3) = 10 - worker;
+            max_grid.local(worker).at(2, 3) = 10 - worker;
+        }
+
+        const Grid<int> min = min_grid.merge_min();
+        const Grid<int> max = max_grid.merge_max();
+
+        CHECK(min.at(2, 3) == 8);
+        CHECK(max.at(2, 3) == 10);
+        CHECK(min.at(0, 0) == std::numeric_limits<int>::max());
+        CHECK(max.at(0, 0) == std::numeric_limits<int>::min());
+    }
+
+    SECTION("merge() with custom operation")
+    {
+        ThreadLocalGrid<int, Coords<int>, 4> grid{4, 4, 4, 1};
+
+        for (int worker = 0; worker < 4; ++worker)
+            grid.local(worker).at(1, 1) = 2;
+
+        CHECK(grid.merge([](int a, int b) { return a * b; }).at(1, 1) == 16);
+    }
+
+    SECTION("can scatter from multiple threads")
+    {
+        ThreadLocalGrid<int> grid{300, 200, 4};
+        std::vector<std::thread> threads;
+
+        for (int worker = 0; worker < grid.workers(); ++worker) {
+            threads.emplace_back([&grid, worker] {
+                auto local = grid.local(worker);
+
+                for (int i = 0; i < 1000; ++i)
+                    local.at((i * 7) % 300, (i * 13) % 200) += 1;
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        const Grid<int> sum = grid.merge_sum();
+
+        CHECK(std::accumulate(sum.begin(), sum.end(), 0) == 4000);
+    }
+}
@@ -0,0 +1,112 @@
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../grid.hpp"
+#include "../torus_view.hpp"
+
+Grid<int> create_grid_with_test_values(int cols, int rows);
+
+template <typename Range>
+std::vector<int> torus_values(const Range& range)
+{
+    std::vector<int> result;
+
+    for (const auto value : range)
+        result.push_back(value);
+
+    return result;
+}
+
+TEST_CASE("TorusView")
+{
+    Grid<int> grid = create_grid_with_test_values(5, 4);
+    const TorusView<Grid<int>> torus{grid};
+
+    SECTION("wrap() maps any position into the grid")
+    {
+        CHECK(TorusView<Grid<int>>::wrap(0, 5) == 0);
+        CHECK(TorusView<Grid<int>>::wrap(4, 5) == 4);
+        CHECK(TorusView<Grid<int>>::wrap(5, 5) == 0);
+        CHECK(TorusView<Grid<int>>::wrap(-1, 5) == 4);
+        CHECK(TorusView<Grid<int>>::wrap(-5, 5) == 0);
+        CHECK(TorusView<Grid<int>>::wrap(12, 5) == 2);
+        CHECK(TorusView<Grid<int>>::wrap(-12, 5) == 3);
+        CHECK(torus.wrap(Coords{-1, 9}) == Coords{4, 1});
+    }
+
+    SECTION("at() wraps coordinates")
+    {
+        CHECK(torus.at(0, 0) == 11);
+        CHECK(torus.at(-1, 0) == 15);
+        CHECK(torus.at(5, 4) == 11);
+        CHECK(torus.at(Coords{-2, -1}) == 44);
+        CHECK(torus.at(23, -13) == 44);
+
+        torus.at(-1, -1) = 100;
+
+        CHECK(grid.at(4, 3) == 100);
+    }
+
+    SECTION("can be used with const Grids")
+    {
+        const Grid<int>& const_grid = grid;
+        const TorusView<const Grid<int>> const_torus{const_grid};
+
+        CHECK(const_torus.at(7, 5) == 23);
+        CHECK(const_torus.cell(-1, -1).value() == 45);
+    }
+
+    SECTION("moving cells wraps around")
+    {
+        auto cell = torus.cell(0, 0);
+
+        cell.move_left();
+        CHECK(cell.coords() == Coords{4, 0});
+        CHECK(cell.value() == 15);
+
+        cell.move_up();
+        CHECK(cell.coords() == Coords{4, 3});
+        CHECK(cell.value() == 45);
+
+        cell.move(2, 3);
+        CHECK(cell.coords() == Coords{1, 2});
+        CHECK(cell.value() == 32);
+
+        cell.move(-12, 9);
+        CHECK(cell.coords() == Coords{4, 3});
+        CHECK(cell.value() == 45);
+
+        cell.move_right(6);
+        CHECK(cell.coords() == Coords{0, 3});
+        CHECK(cell.value() == 41);
+    }
+
+    SECTION("neighbors wrap around")
+    {
+        CHECK(torus_values(torus.cell(0, 0).neighbors4()) == std::vector{41, 15, 12, 21});
+        CHECK(torus_values(torus.cell(2, 1).neighbors4()) == std::vector{13, 22, 24, 33});
+        CHECK(torus_values(torus.cell(4, 3).neighbors8()) == std::vector{34, 35, 31, 44, 41, 14, 15, 11});
+        CHECK(torus.cell(-1, -1).neighborhood<2>().size() == 24);
+    }
+
+    SECTION("rows and columns wrap around")
+    {
+        CHECK(torus_values(torus.row(1)) == std::vector{21, 22, 23, 24, 25});
+        CHECK(torus_values(torus.row(-1, -1, 7)) == std::vector{45, 41, 42, 43, 44, 45, 41});
+        CHECK(torus_values(torus.col(6)) == std::vector{12, 22, 32, 42});
+        CHECK(torus_values(torus.col(0, 2, 6)) == std::vector{31, 41, 11, 21, 31, 41});
+
+        const auto row = torus.row(0, -2, 9);
+
+        CHECK(row.size() == 9);
+        CHECK(row[0] == 14);
+        CHECK(row[8] == 12);
+        CHECK(row.end() - row.begin() == 9);
+        CHECK(*(row.begin() + 7) == 11);
+        CHECK(*(row.end() - 1) == 12);
+        CHECK(*--(row.begin() + 2) == 15);
+        CHECK(row.begin()[3] == 12);
+        CHECK(row.begin() < row.end());
+    }
+}
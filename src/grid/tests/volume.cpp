@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "../volume.hpp"
+
+Volume<int> create_volume_with_test_values(const int cols, const int rows, const int slices)
+{
+    Volume<int> volume{cols, rows, slices};
+
+    for (int z = 0; z < slices; ++z)
+        for (int y = 0; y < rows; ++y)
+            for (int x = 0; x < cols; ++x)
+                volume.at(x, y, z) = (z + 1) * 100 + (y + 1) * 10 + x + 1;
+
+    return volume;
+}
+
+TEST_CASE("Volume")
+{
+    SECTION("creation")
+    {
+        const Volume<int> volume1{4, 3, 2};
+        const Volume<int> volume2{4, 3, 2, -1};
+
+        CHECK(volume1.width() == 4);
+        CHECK(volume1.height() == 3);
+        CHECK(volume1.depth() == 2);
+        CHECK(volume1.size() == 24);
+        CHECK(std::all_of(volume1.begin(), volume1.end(), [](int i) { return i == 0; }));
+        CHECK(std::all_of(volume2.begin(), volume2.end(), [](int i) { return i == -1; }));
+    }
+
+    SECTION("is stored slice by slice, row by row")
+    {
+        const auto volume = create_volume_with_test_values(4, 3, 2);
+
+        CHECK(volume.data()[0] == 111);
+        CHECK(volume.data()[1] == 112);
+        CHECK(volume.data()[4] == 121);
+        CHECK(volume.data()[12] == 211);
+        CHECK(volume.at(3, 2, 1) == 234);
+        CHECK(volume.at(Coords3{1, 2, 0}) == 132);
+    }
+
+    SECTION("cell()")
+    {
+        auto volume = create_volume_with_test_values(4, 3, 2);
+        auto cell = volume.cell({1, 1, 1});
+
+        CHECK(cell.value() == 222);
+
+        cell.move_in_depth(-1);
+        cell.value() = 0;
+        CHECK(volume.at(1, 1, 0) == 0);
+    }
+
+    SECTION("neighbors6() returns the cells sharing a face, in the slice of the cell and the ones next to it")
+    {
+        const auto volume = create_volume_with_test_values(4, 3, 3);
+        const auto values = [](const auto& neighbors) { return std::vector<int>(neighbors.begin(), neighbors.end()); };
+
+        CHECK(values(volume.cell({1, 1, 1}).neighbors6()) == std::vector{122, 212, 221, 223, 232, 322});
+        CHECK(values(volume.cell({1, 1, 2}).neighbors6()) == std::vector{222, 312, 321, 323, 332});
+        CHECK(values(volume.cell({3, 2, 2}).neighbors6(BorderMode::clamp)) == std::vector{234, 324, 333, 334, 334, 334});
+        CHECK(values(volume.cell({0, 0, 2}).neighbors6(BorderMode::wrap)) == std::vector{211, 331, 314, 312, 321, 111});
+    }
+
+    SECTION("slice()")
+    {
+        auto volume = create_volume_with_test_values(4, 3, 2);
+        auto slice = volume.slice(1);
+
+        CHECK(slice.width() == 4);
+        CHECK(slice.height() == 3);
+        CHECK(slice.size() == 12);
+        CHECK(slice.at(2, 1) == 223);
+        CHECK(std::vector(slice.row(2).begin(), slice.row(2).end()) == std::vector{231, 232, 233, 234});
+        CHECK(std::vector(slice.col(3).begin(), slice.col(3).end()) == std::vector{214, 224, 234});
+        CHECK(std::accumulate(slice.begin(), slice.end(), 0) == 12 * 200 + 4 * (10 + 20 + 30) + 3 * (1 + 2 + 3 + 4));
+
+        slice.at(0, 0) = 0;
+        CHECK(volume.at(0, 0, 1) == 0);
+    }
+
+    SECTION("x, y and z lines")
+    {
+        auto volume = create_volume_with_test_values(4, 3, 2);
+        const auto& const_volume = volume;
+
+        CHECK(std::vector(const_volume.x_line(1, 1).begin(), const_volume.x_line(1, 1).end()) == std::vector{221, 222, 223, 224});
+        CHECK(std::vector(const_volume.y_line(2, 0).begin(), const_volume.y_line(2, 0).end()) == std::vector{113, 123, 133});
+        CHECK(std::vector(const_volume.z_line(3, 2).begin(), const_volume.z_line(3, 2).end()) == std::vector{134, 234});
+        CHECK(std::vector(volume.z_line(0, 0).rbegin(), volume.z_line(0, 0).rend()) == std::vector{211, 111});
+
+        auto line = volume.z_line(1, 1);
+        CHECK(line.size() == 2);
+        CHECK(line.front() == 122);
+        CHECK(line.back() == 222);
+        CHECK(line.end() - line.begin() == 2);
+
+        line[1] = 0;
+        CHECK(volume.at(1, 1, 1) == 0);
+    }
+
+    SECTION("reductions along each axis")
+    {
+        const auto volume = create_volume_with_test_values(4, 3, 2);
+
+        const Grid<int> x_sums = volume.reduce_x(0, std::plus<>{});
+        const Grid<int> y_sums = volume.reduce_y(0, std::plus<>{});
+        const Grid<int> z_max = volume.reduce_z(0, [](int a, int b) { return std::max(a, b); });
+
+        CHECK(x_sums.width() == 3);
+        CHECK(x_sums.height() == 2);
+        CHECK(x_sums.at(1, 0) == 121 + 122 + 123 + 124);
+        CHECK(x_sums.at(2, 1) == 231 + 232 + 233 + 234);
+
+        CHECK(y_sums.width() == 4);
+        CHECK(y_sums.height() == 2);
+        CHECK(y_sums.at(0, 0) == 111 + 121 + 131);
+        CHECK(y_sums.at(3, 1) == 214 + 224 + 234);
+
+        CHECK(z_max.width() == 4);
+        CHECK(z_max.height() == 3);
+        CHECK(z_max.at(0, 0) == 211);
+        CHECK(z_max.at(3, 2) == 234);
+    }
+
+    SECTION("reduce_z() equals summing each z line")
+    {
+        const auto volume = create_volume_with_test_values(5, 4, 3);
+        const Grid<int> sums = volume.reduce_z(0, std::plus<>{});
+
+        for (int y = 0; y < 4; ++y)
+            for (int x = 0; x < 5; ++x)
+                CHECK(sums.at(x, y) == std::accumulate(volume.z_line(x, y).begin(), volume.z_line(x, y).end(), 0));
+    }
+}
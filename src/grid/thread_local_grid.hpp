@@ -0,0 +1,178 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+#include "grid.hpp"
+
+// Scatter target for multiple worker threads: every worker writes into its own tiles, which only get allocated
+// (and filled with the identity value) when the worker touches them for the first time. merge() combines the
+// workers with a parallel tree reduction into a regular Grid.
+template <typename T = int, typename CoordsType = Coords<int>, int TileSize = 64>
+class ThreadLocalGrid {
+public:
+    using size_type = int;
+    using value_type = T;
+    using reference = T&;
+    using coords_type = CoordsType;
+
+    static_assert(TileSize > 0 && (TileSize & (TileSize - 1)) == 0, "tile size must be a power of two");
+
+private:
+    using tile_type = std::vector<T>;
+    using tiles_type = std::vector<tile_type>;
+
+public:
+    class Accumulator {
+    public:
+        [[nodiscard]] reference at(size_type col, size_type row);
+        [[nodiscard]] reference at(const coords_type& coords) { return at(coords.col(), coords.row()); }
+
+        size_type allocated_tiles() const { return static_cast<size_type>(std::count_if(tiles_->begin(), tiles_->end(), [](const tile_type& tile) { return !tile.empty(); })); }
+
+    private:
+        friend class ThreadLocalGrid;
+
+        Accumulator(const ThreadLocalGrid* grid, tiles_type* tiles) : grid_{grid}, tiles_{tiles} { }
+
+        const ThreadLocalGrid* grid_;
+        tiles_type* tiles_;
+    };
+
+    ThreadLocalGrid(size_type cols, size_type rows, int workers, const T& identity = T{});
+
+    size_type width() const { return cols_; }
+    size_type height() const { return rows_; }
+
+    int workers() const { return static_cast<int>(workers_.size()); }
+
+    [[nodiscard]] Accumulator local(const int worker)
+    {
+        assert(worker >= 0 && worker < workers());
+        return Accumulator{this, &workers_[static_cast<std::size_t>(worker)]};
+    }
+
+    size_type allocated_tiles() const;
+
+    template <typename BinaryOp>
+    [[nodiscard]] Grid<T, coords_type> merge(BinaryOp op);
+
+    [[nodiscard]] Grid<T, coords_type> merge_sum() { return merge([](const T& a, const T& b) { return a + b; }); }
+    [[nodiscard]] Grid<T, coords_type> merge_min() { return merge([](const T& a, const T& b) { return std::min(a, b); }); }
+    [[nodiscard]] Grid<T, coords_type> merge_max() { return merge([](const T& a, const T& b) { return std::max(a, b); }); }
+
+private:
+    size_type cols_;
+    size_type rows_;
+    size_type tile_cols_;
+    size_type tile_rows_;
+    T identity_;
+
+    std::vector<tiles_type> workers_;
+
+    [[nodiscard]] size_type tile_width(size_type tile_col) const { return std::min(TileSize, cols_ - tile_col * TileSize); }
+    [[nodiscard]] size_type tile_height(size_type tile_row) const { return std::min(TileSize, rows_ - tile_row * TileSize); }
+
+    template <typename BinaryOp>
+    static void merge_tiles(tiles_type& dst, tiles_type& src, BinaryOp op);
+};
+
+template <typename T, typename CoordsType, int TileSize>
+ThreadLocalGrid<T, CoordsType, TileSize>::ThreadLocalGrid(const size_type cols, const size_type rows, const int workers, const T& identity) : identity_{identity}
+{
+    assert(cols > 0 && rows > 0);
+    assert(cols - 1 <= coords_type::max());
+    assert(rows - 1 <= coords_type::max());
+    assert(workers > 0);
+    cols_ = cols;
+    rows_ = rows;
+    tile_cols_ = (cols + TileSize - 1) / TileSize;
+    tile_rows_ = (rows + TileSize - 1) / TileSize;
+    workers_ = std::vector<tiles_type>(static_cast<std::size_t>(workers), tiles_type(static_cast<std::size_t>(tile_cols_ * tile_rows_)));
+}
+
+template <typename T, typename CoordsType, int TileSize>
+typename ThreadLocalGrid<T, CoordsType, TileSize>::reference ThreadLocalGrid<T, CoordsType, TileSize>::Accumulator::at(const size_type col, const size_type row)
+{
+    assert(col >= 0 && col < grid_->cols_);
+    assert(row >= 0 && row < grid_->rows_);
+
+    const size_type tile_col = col / TileSize;
+    const size_type tile_width = grid_->tile_width(tile_col);
+    auto& tile = (*tiles_)[static_cast<std::size_t>((row / TileSize) * grid_->tile_cols_ + tile_col)];
+
+    if (tile.empty())
+        tile.assign(static_cast<std::size_t>(tile_width * grid_->tile_height(row / TileSize)), grid_->identity_);
+
+    return tile[static_cast<std::size_t>((row & (TileSize - 1)) * tile_width + (col & (TileSize - 1)))];
+}
+
+template <typename T, typename CoordsType, int TileSize>
+typename ThreadLocalGrid<T, CoordsType, TileSize>::size_type ThreadLocalGrid<T, CoordsType, TileSize>::allocated_tiles() const
+{
+    size_type count = 0;
+
+    for (const auto& tiles : workers_)
+        count += static_cast<size_type>(std::count_if(tiles.begin(), tiles.end(), [](const tile_type& tile) { return !tile.empty(); }));
+
+    return count;
+}
+
+// Combines all workers into the first one, in each round merging pairs of workers (0 <- 1, 2 <- 3, ...) in parallel,
+// then copies the result into a Grid. Cells no worker has touched keep the identity value.
+// Afterwards all workers are empty again and can be reused.
+template <typename T, typename CoordsType, int TileSize>
+template <typename BinaryOp>
+Grid<T, CoordsType> ThreadLocalGrid<T, CoordsType, TileSize>::merge(BinaryOp op)
+{
+    const std::size_t count = workers_.size();
+
+    for (std::size_t distance = 1; distance < count; distance *= 2) {
+        std::vector<std::jthread> threads;
+
+        for (std::size_t dst = 0; dst + distance < count; dst += 2 * distance)
+            threads.emplace_back([&, dst] { merge_tiles(workers_[dst], workers_[dst + distance], op); });
+    }
+
+    Grid<T, coords_type> grid{cols_, rows_, identity_};
+    auto& tiles = workers_.front();
+
+    for (size_type tile_row = 0; tile_row < tile_rows_; ++tile_row) {
+        for (size_type tile_col = 0; tile_col < tile_cols_; ++tile_col) {
+            auto& tile = tiles[static_cast<std::size_t>(tile_row * tile_cols_ + tile_col)];
+
+            if (tile.empty())
+                continue;
+
+            const size_type tile_width = this->tile_width(tile_col);
+
+            for (size_type row = 0; row < tile_height(tile_row); ++row) {
+                const auto first = tile.begin() + row * tile_width;
+                std::copy(first, first + tile_width, &grid.at(tile_col * TileSize, tile_row * TileSize + row));
+            }
+
+            tile = tile_type{};
+        }
+    }
+
+    return grid;
+}
+
+template <typename T, typename CoordsType, int TileSize>
+template <typename BinaryOp>
+void ThreadLocalGrid<T, CoordsType, TileSize>::merge_tiles(tiles_type& dst, tiles_type& src, BinaryOp op)
+{
+    for (std::size_t i = 0; i < dst.size(); ++i) {
+        if (src[i].empty())
+            continue;
+
+        if (dst[i].empty()) {
+            dst[i].swap(src[i]);
+        } else {
+            std::transform(dst[i].begin(), dst[i].end(), src[i].begin(), dst[i].begin(), op);
+            src[i] = tile_type{};
+        }
+    }
+}
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "neighborhood.hpp"
+
+// View of a Grid (or const Grid) as a torus: coordinates of any size wrap around to the opposite side.
+// Wrapping is done without a modulo as long as the coordinates are at most one width or height outside of the grid,
+// cells keep their linear offset and only wrap when crossing a border, neighborhoods use the BorderMode::wrap
+// fast path for interior cells and the wrapped row and column ranges step with a compare instead of a modulo.
+template <typename GridType>
+class TorusView {
+public:
+    using size_type = int;
+    using difference_type = std::ptrdiff_t;
+    using value_type = typename GridType::value_type;
+    using coords_type = typename GridType::coords_type;
+    using coordinates_type = typename coords_type::coordinates_type;
+    using pointer = decltype(std::declval<GridType&>().data());
+    using reference = decltype(*std::declval<pointer>());
+
+    // position in [0, size)
+    template <std::integral I>
+    [[nodiscard]] static constexpr I wrap(const I pos, const I size)
+    {
+        if (pos >= 0 && pos < size)
+            return pos;
+        if (pos < 0 && pos >= -size)
+            return static_cast<I>(pos + size);
+        if (pos >= size && pos < 2 * size)
+            return static_cast<I>(pos - size);
+
+        return static_cast<I>((pos % size + size) % size);
+    }
+
+private:
+    // Iterates over size values of a row or column with the given stride, starting at any position
+    // and wrapping around at the end (and beginning) of the row or column.
+    class WrappingIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = TorusView::value_type;
+        using difference_type = TorusView::difference_type;
+        using pointer = TorusView::pointer;
+        using reference = TorusView::reference;
+
+        WrappingIterator() : ptr_{}, stride_{}, size_{}, pos_{}, idx_{} { }
+        WrappingIterator(pointer ptr, const difference_type stride, const difference_type size, const difference_type pos)
+        {
+            assert(ptr != nullptr);
+            assert(stride > 0);
+            assert(size > 0);
+            ptr_ = ptr;
+            stride_ = stride;
+            size_ = size;
+            pos_ = pos;
+            idx_ = wrap(pos, size);
+        }
+
+        reference operator*() const { return ptr_[idx_ * stride_]; }
+        pointer operator->() const { return &ptr_[idx_ * stride_]; }
+
+        WrappingIterator& operator++()
+        {
+            ++pos_;
+
+            if (++idx_ == size_)
+                idx_ = 0;
+
+            return *this;
+        }
+
+        WrappingIterator operator++(int)
+        {
+            const WrappingIterator tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+
+        WrappingIterator& operator--()
+        {
+            --pos_;
+
+            if (idx_-- == 0)
+                idx_ = size_ - 1;
+
+            return *this;
+        }
+
+        WrappingIterator operator--(int)
+        {
+            const WrappingIterator tmp{*this};
+            --(*this);
+            return tmp;
+        }
+
+        WrappingIterator& operator+=(const difference_type off)
+        {
+            pos_ += off;
+            idx_ = wrap(idx_ + off, size_);
+            return *this;
+        }
+
+        WrappingIterator& operator-=(const difference_type off) { return *this += -off; }
+
+        WrappingIterator operator+(const difference_type off) const { return WrappingIterator{ptr_, stride_, size_, pos_ + off}; }
+        WrappingIterator operator-(const difference_type off) const { return WrappingIterator{ptr_, stride_, size_, pos_ - off}; }
+        friend WrappingIterator operator+(const difference_type off, const WrappingIterator& a) { return a + off; }
+        friend difference_type operator-(const WrappingIterator& a, const WrappingIterator& b) { return a.pos_ - b.pos_; }
+
+        reference operator[](const difference_type off) const { return *(*this + off); }
+
+        auto operator<=>(const WrappingIterator& rhs) const { return pos_ <=> rhs.pos_; }
+        bool operator==(const WrappingIterator& rhs) const { return pos_ == rhs.pos_; }
+
+    private:
+        pointer ptr_;
+        difference_type stride_;
+        difference_type size_;
+        difference_type pos_;  // unwrapped position, for comparisons and distances
+        difference_type idx_;  // wrapped position
+    };
+
+    // count values of a row or column beginning at first, for example from -1 to width for a stencil with radius 1
+    class WrappingLine {
+    public:
+        using iterator = WrappingIterator;
+
+        WrappingLine(pointer ptr, const difference_type stride, const size_type size, const size_type first, const size_type count)
+            : ptr_{ptr}, stride_{stride}, size_{size}, first_{first}, count_{count}
+        {
+            assert(count >= 0);
+        }
+
+        size_type size() const { return count_; }
+
+        iterator begin() const { return iterator{ptr_, stride_, size_, first_}; }
+        iterator end() const { return iterator{ptr_, stride_, size_, static_cast<difference_type>(first_) + count_}; }
+
+        reference operator[](const size_type pos) const { return ptr_[wrap(first_ + pos, size_) * stride_]; }
+
+    private:
+        pointer ptr_;
+        difference_type stride_;
+        size_type size_;
+        size_type first_;
+        size_type count_;
+    };
+
+    // Like GridCursor, a cell that keeps its linear offset, but moving across a border wraps around.
+    class TorusCell {
+    public:
+        TorusCell(GridType* grid, const coords_type& coords) : grid_{grid}, coords_{coords}
+        {
+            assert(grid != nullptr);
+            assert(coords.col() >= 0 && coords.col() < grid->width());
+            assert(coords.row() >= 0 && coords.row() < grid->height());
+            offset_ = static_cast<difference_type>(coords.row()) * grid->width() + coords.col();
+        }
+
+        [[nodiscard]] reference value() const { return grid_->data()[offset_]; }
+
+        [[nodiscard]] const coords_type& coords() const { return coords_; }
+        [[nodiscard]] coordinates_type col() const { return coords_.col(); }
+        [[nodiscard]] coordinates_type row() const { return coords_.row(); }
+
+        void move(const int dx, const int dy)
+        {
+            move_horizontally(dx);
+            move_vertically(dy);
+        }
+
+        void move_horizontally(const int distance)
+        {
+            const int x = coords_.col();
+            const int wrapped = wrap(x + distance, grid_->width());
+            coords_.move_horizontally(wrapped - x);
+            offset_ += wrapped - x;
+        }
+
+        void move_vertically(const int distance)
+        {
+            const int y = coords_.row();
+            const int wrapped = wrap(y + distance, grid_->height());
+            coords_.move_vertically(wrapped - y);
+            offset_ += static_cast<difference_type>(wrapped - y) * grid_->width();
+        }
+
+        void move_up(const int distance = 1) { move_vertically(-distance); }
+        void move_down(const int distance = 1) { move_vertically(distance); }
+        void move_left(const int distance = 1) { move_horizontally(-distance); }
+        void move_right(const int distance = 1) { move_horizontally(distance); }
+
+        [[nodiscard]] auto neighbors4() const { return Neighborhood<GridType*, coords_type, 1, false>{grid_, coords_, BorderMode::wrap}; }
+        [[nodiscard]] auto neighbors8() const { return Neighborhood<GridType*, coords_type, 1, true>{grid_, coords_, BorderMode::wrap}; }
+
+        template <int Radius>
+        [[nodiscard]] auto neighborhood() const { return Neighborhood<GridType*, coords_type, Radius, true>{grid_, coords_, BorderMode::wrap}; }
+
+        bool operator==(const TorusCell& rhs) const { return coords_ == rhs.coords_; }
+
+    private:
+        GridType* grid_;
+        coords_type coords_;
+        difference_type offset_;
+    };
+
+public:
+    using line_type = WrappingLine;
+    using cell_type = TorusCell;
+
+    explicit TorusView(GridType& grid) : grid_{&grid} { }
+
+    size_type width() const { return grid_->width(); }
+    size_type height() const { return grid_->height(); }
+
+    [[nodiscard]] coords_type wrap(const coords_type& coords) const { return coords_type{static_cast<coordinates_type>(wrap(static_cast<int>(coords.col()), width())), static_cast<coordinates_type>(wrap(static_cast<int>(coords.row()), height()))}; }
+
+    [[nodiscard]] reference at(const size_type col, const size_type row) const { return grid_->data()[wrap(row, height()) * width() + wrap(col, width())]; }
+    [[nodiscard]] reference at(const coords_type& coords) const { return at(coords.col(), coords.row()); }
+
+    [[nodiscard]] cell_type cell(const size_type col, const size_type row) const { return cell_type{grid_, coords_type{static_cast<coordinates_type>(wrap(col, width())), static_cast<coordinates_type>(wrap(row, height()))}}; }
+    [[nodiscard]] cell_type cell(const coords_type& coords) const { return cell_type{grid_, wrap(coords)}; }
+
+    [[nodiscard]] line_type row(const size_type pos) const { return row(pos, 0, width()); }
+    [[nodiscard]] line_type row(const size_type pos, const size_type first_col, const size_type count) const { return line_type{&at(0, pos), 1, width(), first_col, count}; }
+
+    [[nodiscard]] line_type col(const size_type pos) const { return col(pos, 0, height()); }
+    [[nodiscard]] line_type col(const size_type pos, const size_type first_row, const size_type count) const { return line_type{&at(pos, 0), width(), height(), first_row, count}; }
+
+private:
+    GridType* grid_;
+};
@@ -0,0 +1,120 @@
+// Traces the memory accesses of a few algorithms on a Grid and reports their locality: a heatmap of the accessed
+// indices over time as PGM image and the reuse distances of the cache lines in row-major, tiled and Morton layout.
+// usage: grid_trace [size] [output directory]
+
+#if !defined(GRID_ACCESS_TRACING)
+#error "grid_trace has to be built with GRID_ACCESS_TRACING"
+#endif
+
+#include <charconv>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "fmt/core.h"
+
+#include "access_trace.hpp"
+#include "access_trace_report.hpp"
+#include "grid.hpp"
+
+struct TracedAlgorithm {
+    const char* name;
+    std::function<void(Grid<int>&)> run;
+};
+
+void trace_algorithm(const TracedAlgorithm& algorithm, Grid<int>& grid, const std::string& output_directory)
+{
+    AccessTrace& trace = AccessTrace::global();
+    trace.clear();
+    algorithm.run(grid);
+
+    const std::uint64_t recorded = trace.recorded();
+    const auto accesses = grid_accesses(trace.snapshot(), grid);
+
+    fmt::print("{}: {} accesses\n", algorithm.name, recorded);
+
+    if (recorded > trace.capacity())
+        fmt::print("  only the last {} accesses fit into the trace buffer\n", trace.capacity());
+
+    const std::string filename = fmt::format("{}/{}.pgm", output_directory, algorithm.name);
+    std::ofstream image{filename, std::ios::binary};
+    write_pgm(image, locality_heatmap(accesses, static_cast<std::size_t>(grid.size()), 512, 256));
+
+    if (!image)
+        std::cerr << "could not write " << filename << "\n";
+
+    for (const auto& [layout, layout_name] : {std::pair{TraceLayout::row_major, "row-major"}, std::pair{TraceLayout::tiled, "8x8 tiles"}, std::pair{TraceLayout::morton, "Morton"}}) {
+        fmt::print(" {}\n", layout_name);
+        write_reuse_distance_report(std::cout, reuse_distances(accesses, grid.width(), layout, sizeof(int)));
+    }
+
+    fmt::print("\n");
+}
+
+int main(int argc, char* argv[])
+{
+    const std::span args{argv, static_cast<std::size_t>(argc)};
+    int size = 512;
+
+    if (args.size() > 1) {
+        const std::string_view arg{args[1]};
+        const auto [ptr, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), size);
+
+        if (ec != std::errc{} || ptr != arg.data() + arg.size() || size <= 0) {
+            std::cerr << "usage: grid_trace [size] [output directory]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    const std::string output_directory = args.size() > 2 ? args[2] : ".";
+
+    const TracedAlgorithm algorithms[] = {
+        {"sum_rows", [](Grid<int>& grid) {
+             int sum = 0;
+
+             for (const auto& row : std::as_const(grid).rows())
+                 for (const auto value : row)
+                     sum += value;
+
+             grid.at(0, 0) = sum;
+         }},
+        {"sum_columns", [](Grid<int>& grid) {
+             int sum = 0;
+
+             for (const auto& col : std::as_const(grid).cols())
+                 for (const auto value : col)
+                     sum += value;
+
+             grid.at(0, 0) = sum;
+         }},
+        {"transpose", [](Grid<int>& grid) {
+             for (int y = 0; y < grid.height(); ++y)
+                 for (int x = y + 1; x < grid.width(); ++x)
+                     std::swap(grid.at(x, y), grid.at(y, x));
+         }},
+        {"neighbors8", [](Grid<int>& grid) {
+             const Grid<int>& input = grid;
+             int sum = 0;
+
+             for (int y = 0; y < grid.height(); ++y)
+                 for (int x = 0; x < grid.width(); ++x)
+                     for (const auto value : input.cell(x, y).neighbors8())
+                         sum += value;
+
+             grid.at(0, 0) = sum;
+         }},
+    };
+
+    Grid<int> grid{size, size, 1};
+
+    for (const auto& algorithm : algorithms)
+        trace_algorithm(algorithm, grid, output_directory);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,370 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "coords3.hpp"
+#include "grid.hpp"
+#include "neighborhood.hpp"
+#include "strided_iterator.hpp"
+
+// Three-dimensional counterpart of Grid, stored slice by slice (z), each slice row by row (y).
+// Lines along x are contiguous, lines along y have a stride of width and lines along z a stride of width * height,
+// so iterating those one by one touches a new cache line (or page) per value. The reductions along y and z
+// therefore walk the volume in memory order and accumulate whole rows at once instead.
+template <typename T = int, typename CoordsType = Coords3<int>>
+class Volume {
+public:
+    using difference_type = std::ptrdiff_t;
+    using size_type = int;
+
+private:
+    template <typename pointer, typename reference>
+    using ValueIterator = StridedIterator<pointer, reference>;
+
+    // values along one axis
+    template <typename pointer, typename reference>
+    class Line {
+    public:
+        using iterator = ValueIterator<pointer, reference>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+
+        Line(pointer ptr, const size_type size, const difference_type stride) : ptr_{ptr}, size_{size}, stride_{stride}
+        {
+            assert(ptr != nullptr);
+            assert(size > 0);
+            assert(stride > 0);
+        }
+
+        size_type size() const { return size_; }
+
+        iterator begin() const { return iterator{ptr_, stride_}; }
+        iterator end() const { return iterator{ptr_ + size_ * stride_, stride_}; }
+
+        reverse_iterator rbegin() const { return reverse_iterator{end()}; }
+        reverse_iterator rend() const { return reverse_iterator{begin()}; }
+
+        reference front() const { return *ptr_; }
+        reference back() const { return *(ptr_ + (size_ - 1) * stride_); }
+
+        reference operator[](const size_type pos) const
+        {
+            assert(pos >= 0 && pos < size_);
+            return *(ptr_ + pos * stride_);
+        }
+
+    private:
+        pointer ptr_;
+        size_type size_;
+        difference_type stride_;
+    };
+
+    // one z slice, a contiguous width * height plane
+    template <typename pointer, typename reference>
+    class Slice {
+    public:
+        using line_type = Line<pointer, reference>;
+
+        Slice(pointer ptr, const size_type cols, const size_type rows) : ptr_{ptr}, cols_{cols}, rows_{rows} { assert(ptr != nullptr); }
+
+        size_type width() const { return cols_; }
+        size_type height() const { return rows_; }
+        size_type size() const { return cols_ * rows_; }
+
+        pointer data() const { return ptr_; }
+
+        pointer begin() const { return ptr_; }
+        pointer end() const { return ptr_ + size(); }
+
+        [[nodiscard]] reference at(const size_type col, const size_type row) const
+        {
+            assert(col >= 0 && col < cols_);
+            assert(row >= 0 && row < rows_);
+            return ptr_[row * cols_ + col];
+        }
+
+        [[nodiscard]] line_type row(const size_type pos) const
+        {
+            assert(pos >= 0 && pos < rows_);
+            return line_type{ptr_ + pos * cols_, cols_, 1};
+        }
+
+        [[nodiscard]] line_type col(const size_type pos) const
+        {
+            assert(pos >= 0 && pos < cols_);
+            return line_type{ptr_ + pos, rows_, cols_};
+        }
+
+    private:
+        pointer ptr_;
+        size_type cols_;
+        size_type rows_;
+    };
+
+    // The up to six cells sharing a face with a center cell in memory order, resolved to pointers like Neighborhood.
+    template <typename pointer, typename reference>
+    class FaceNeighbors {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::remove_cvref_t<reference>;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+            explicit iterator(const pointer* pos) : pos_{pos} { }
+
+            reference operator*() const { return **pos_; }
+
+            iterator& operator++()
+            {
+                ++pos_;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                iterator tmp = *this;
+                ++pos_;
+                return tmp;
+            }
+
+            bool operator==(const iterator& other) const = default;
+
+        private:
+            const pointer* pos_ = nullptr;
+        };
+
+        template <typename VolumePointer>
+        FaceNeighbors(VolumePointer volume, const CoordsType& center, const BorderMode mode)
+        {
+            constexpr std::array<std::array<int, 3>, 6> offsets{{{0, 0, -1}, {0, -1, 0}, {-1, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};
+            const std::array<int, 3> extents{volume->width(), volume->height(), volume->depth()};
+
+            for (const auto& offset : offsets) {
+                std::array<int, 3> pos{center.col() + offset[0], center.row() + offset[1], center.slice() + offset[2]};
+                bool outside = false;
+
+                for (std::size_t axis = 0; axis < pos.size(); ++axis) {
+                    if (pos[axis] >= 0 && pos[axis] < extents[axis])
+                        continue;
+
+                    switch (mode) {
+                        case BorderMode::skip:
+                            outside = true;
+                            break;
+                        case BorderMode::clamp:
+                            pos[axis] = pos[axis] < 0 ? 0 : extents[axis] - 1;
+                            break;
+                        case BorderMode::wrap:
+                            pos[axis] = (pos[axis] % extents[axis] + extents[axis]) % extents[axis];
+                            break;
+                    }
+                }
+
+                if (!outside)
+                    neighbors_[static_cast<std::size_t>(size_++)] = &volume->at(pos[0], pos[1], pos[2]);
+            }
+        }
+
+        size_type size() const { return size_; }
+
+        iterator begin() const { return iterator{neighbors_.data()}; }
+        iterator end() const { return iterator{neighbors_.data() + size_}; }
+
+        reference operator[](const size_type pos) const
+        {
+            assert(pos >= 0 && pos < size_);
+            return *neighbors_[static_cast<std::size_t>(pos)];
+        }
+
+    private:
+        std::array<pointer, 6> neighbors_{};
+        size_type size_ = 0;
+    };
+
+    // The 3D counterpart of GridCell, GridCell's neighbors only know rows and columns.
+    template <typename VolumePointer, typename pointer, typename reference>
+    class Cell : public CoordsType {
+    public:
+        Cell(VolumePointer volume, const CoordsType& coords) : CoordsType(coords)
+        {
+            assert(volume != nullptr);
+            volume_ = volume;
+        }
+
+        [[nodiscard]] reference value() { return volume_->at(*this); }
+
+        [[nodiscard]] FaceNeighbors<pointer, reference> neighbors6(const BorderMode mode = BorderMode::skip) const { return {volume_, *this, mode}; }
+
+    private:
+        VolumePointer volume_;
+    };
+
+public:
+    using value_type = T;
+    using pointer = T*;
+    using reference = T&;
+    using const_pointer = const T*;
+    using const_reference = const T&;
+    using coords_type = CoordsType;
+    using line_type = Line<pointer, reference>;
+    using const_line_type = Line<const_pointer, const_reference>;
+    using slice_type = Slice<pointer, reference>;
+    using const_slice_type = Slice<const_pointer, const_reference>;
+    using volume_cell_type = Cell<Volume*, pointer, reference>;
+    using const_volume_cell_type = Cell<const Volume*, const_pointer, const_reference>;
+
+    Volume(size_type cols, size_type rows, size_type slices);
+    Volume(size_type cols, size_type rows, size_type slices, const T& value);
+
+    size_type width() const { return cols_; }
+    size_type height() const { return rows_; }
+    size_type depth() const { return slices_; }
+
+    size_type size() const { return static_cast<size_type>(data_.size()); }
+
+    pointer data() { return data_.data(); }
+    const_pointer data() const { return data_.data(); }
+
+    [[nodiscard]] reference at(size_type col, size_type row, size_type slice) { return data_[idx(col, row, slice)]; }
+    [[nodiscard]] const_reference at(size_type col, size_type row, size_type slice) const { return data_[idx(col, row, slice)]; }
+
+    [[nodiscard]] reference at(const coords_type& coords) { return data_[idx(coords.col(), coords.row(), coords.slice())]; }
+    [[nodiscard]] const_reference at(const coords_type& coords) const { return data_[idx(coords.col(), coords.row(), coords.slice())]; }
+
+    [[nodiscard]] volume_cell_type cell(const coords_type& coords) { return volume_cell_type{this, coords}; }
+    [[nodiscard]] const_volume_cell_type cell(const coords_type& coords) const { return const_volume_cell_type{this, coords}; }
+
+    auto begin() { return data_.begin(); }
+    auto begin() const { return data_.cbegin(); }
+    auto end() { return data_.end(); }
+    auto end() const { return data_.cend(); }
+
+    [[nodiscard]] slice_type slice(const size_type z) { return slice_type{&data_[idx(0, 0, z)], cols_, rows_}; }
+    [[nodiscard]] const_slice_type slice(const size_type z) const { return const_slice_type{&data_[idx(0, 0, z)], cols_, rows_}; }
+
+    [[nodiscard]] line_type x_line(const size_type row, const size_type slice) { return line_type{&at(0, row, slice), cols_, 1}; }
+    [[nodiscard]] const_line_type x_line(const size_type row, const size_type slice) const { return const_line_type{&at(0, row, slice), cols_, 1}; }
+    [[nodiscard]] line_type y_line(const size_type col, const size_type slice) { return line_type{&at(col, 0, slice), rows_, cols_}; }
+    [[nodiscard]] const_line_type y_line(const size_type col, const size_type slice) const { return const_line_type{&at(col, 0, slice), rows_, cols_}; }
+    [[nodiscard]] line_type z_line(const size_type col, const size_type row) { return line_type{&at(col, row, 0), slices_, slice_stride()}; }
+    [[nodiscard]] const_line_type z_line(const size_type col, const size_type row) const { return const_line_type{&at(col, row, 0), slices_, slice_stride()}; }
+
+    template <typename BinaryOp>
+    [[nodiscard]] Grid<T> reduce_x(const T& init, BinaryOp op) const;
+
+    template <typename BinaryOp>
+    [[nodiscard]] Grid<T> reduce_y(const T& init, BinaryOp op) const;
+
+    template <typename BinaryOp>
+    [[nodiscard]] Grid<T> reduce_z(const T& init, BinaryOp op) const;
+
+private:
+    size_type cols_;
+    size_type rows_;
+    size_type slices_;
+
+    std::vector<T> data_;
+
+    [[nodiscard]] difference_type slice_stride() const { return static_cast<difference_type>(cols_) * rows_; }
+
+    [[nodiscard]] inline std::size_t idx(size_type col, size_type row, size_type slice) const;
+};
+
+template <typename T, typename CoordsType>
+Volume<T, CoordsType>::Volume(const size_type cols, const size_type rows, const size_type slices)
+{
+    assert(cols > 0 && rows > 0 && slices > 0);
+    assert(cols - 1 <= coords_type::max());
+    assert(rows - 1 <= coords_type::max());
+    assert(slices - 1 <= coords_type::max());
+    cols_ = cols;
+    rows_ = rows;
+    slices_ = slices;
+    data_ = std::vector<T>(static_cast<std::size_t>(cols) * static_cast<std::size_t>(rows) * static_cast<std::size_t>(slices));
+}
+
+template <typename T, typename CoordsType>
+Volume<T, CoordsType>::Volume(const size_type cols, const size_type rows, const size_type slices, const T& value)
+{
+    assert(cols > 0 && rows > 0 && slices > 0);
+    assert(cols - 1 <= coords_type::max());
+    assert(rows - 1 <= coords_type::max());
+    assert(slices - 1 <= coords_type::max());
+    cols_ = cols;
+    rows_ = rows;
+    slices_ = slices;
+    data_ = std::vector<T>(static_cast<std::size_t>(cols) * static_cast<std::size_t>(rows) * static_cast<std::size_t>(slices), value);
+}
+
+template <typename T, typename CoordsType>
+std::size_t Volume<T, CoordsType>::idx(const size_type col, const size_type row, const size_type slice) const
+{
+    assert(col >= 0 && col < cols_);
+    assert(row >= 0 && row < rows_);
+    assert(slice >= 0 && slice < slices_);
+    return static_cast<std::size_t>(slice * slice_stride() + row * cols_ + col);
+}
+
+// Combines every x line into one value, the result has one column per row and one row per slice.
+template <typename T, typename CoordsType>
+template <typename BinaryOp>
+Grid<T> Volume<T, CoordsType>::reduce_x(const T& init, BinaryOp op) const
+{
+    Grid<T> result{rows_, slices_, init};
+    const_pointer src = data();
+
+    for (size_type z = 0; z < slices_; ++z) {
+        for (size_type y = 0; y < rows_; ++y, src += cols_) {
+            T& dst = result.at(y, z);
+
+            for (size_type x = 0; x < cols_; ++x)
+                dst = op(dst, src[x]);
+        }
+    }
+
+    return result;
+}
+
+// Combines every y line into one value, the result has one column per column and one row per slice.
+// Instead of following each line (stride width), adds up the rows of each slice into one row of the result.
+template <typename T, typename CoordsType>
+template <typename BinaryOp>
+Grid<T> Volume<T, CoordsType>::reduce_y(const T& init, BinaryOp op) const
+{
+    Grid<T> result{cols_, slices_, init};
+    const_pointer src = data();
+
+    for (size_type z = 0; z < slices_; ++z) {
+        T* dst = &result.at(0, z);
+
+        for (size_type y = 0; y < rows_; ++y, src += cols_)
+            for (size_type x = 0; x < cols_; ++x)
+                dst[x] = op(dst[x], src[x]);
+    }
+
+    return result;
+}
+
+// Combines every z line into one value, the result has the width and height of a slice.
+// Instead of following each line (stride width * height), adds up the slices one after another.
+template <typename T, typename CoordsType>
+template <typename BinaryOp>
+Grid<T> Volume<T, CoordsType>::reduce_z(const T& init, BinaryOp op) const
+{
+    Grid<T> result{cols_, rows_, init};
+    T* dst = result.data();
+    const_pointer src = data();
+    const auto plane = static_cast<std::size_t>(slice_stride());
+
+    for (size_type z = 0; z < slices_; ++z, src += plane)
+        for (std::size_t i = 0; i < plane; ++i)
+            dst[i] = op(dst[i], src[i]);
+
+    return result;
+}
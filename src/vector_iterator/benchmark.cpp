@@ -0,0 +1,188 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include "nanobench.h"
+
+#include <algorithm>
+#include <cstring>
+#include <ratio>
+#include <string>
+#include <vector>
+
+#include "fmt/core.h"
+
+#include "segmented_algorithms.hpp"
+
+#include "custom_vector.hpp"
+#include "segmented_vector.hpp"
+#include "small_vector.hpp"
+
+// long enough to not fit into the small string buffer
+std::string make_string(const int i)
+{
+    return fmt::format("a string that is stored on the heap: {}", i);
+}
+
+template <typename Vector>
+void benchmark_push_back_ints(const char* name)
+{
+    for (auto size : {16, 1024, 1 << 20}) {
+        ankerl::nanobench::Bench().batch(size).unit("push_back").run(fmt::format("push_back ints {}: {}", name, size), [&] {
+            Vector vec;
+
+            for (int i = 0; i < size; ++i)
+                vec.push_back(i);
+
+            ankerl::nanobench::doNotOptimizeAway(vec.back());
+        });
+    }
+}
+
+template <typename Vector>
+void benchmark_push_back_ints_reserved(const char* name)
+{
+    for (auto size : {16, 1024, 1 << 20}) {
+        ankerl::nanobench::Bench().batch(size).unit("push_back").run(fmt::format("push_back ints reserved {}: {}", name, size), [&] {
+            Vector vec;
+            vec.reserve(static_cast<std::size_t>(size));
+
+            for (int i = 0; i < size; ++i)
+                vec.push_back(i);
+
+            ankerl::nanobench::doNotOptimizeAway(vec.back());
+        });
+    }
+}
+
+template <typename Vector>
+void benchmark_push_back_strings(const char* name)
+{
+    for (auto size : {16, 1024, 1 << 16}) {
+        std::vector<std::string> strings;
+
+        for (int i = 0; i < size; ++i)
+            strings.push_back(make_string(i));
+
+        ankerl::nanobench::Bench().batch(size).unit("push_back").run(fmt::format("push_back strings {}: {}", name, size), [&] {
+            Vector vec;
+
+            for (const auto& s : strings)
+                vec.push_back(s);
+
+            ankerl::nanobench::doNotOptimizeAway(vec.data());
+        });
+    }
+}
+
+// many short-lived vectors with a few values each
+template <typename Vector>
+void benchmark_small_vectors(const char* name)
+{
+    for (auto size : {4, 16, 64}) {
+        ankerl::nanobench::Bench().run(fmt::format("small vectors {}: {}", name, size), [&] {
+            Vector vec;
+
+            for (int i = 0; i < size; ++i)
+                vec.push_back(i);
+
+            int sum = 0;
+
+            for (const auto i : vec)
+                sum += i;
+
+            ankerl::nanobench::doNotOptimizeAway(sum);
+        });
+    }
+}
+
+void benchmark_sum_segmented_vector()
+{
+    for (auto size : {1024, 1 << 20}) {
+        SegmentedVector<int> vec;
+
+        for (int i = 0; i < size; ++i)
+            vec.push_back(i);
+
+        ankerl::nanobench::Bench().batch(size).unit("value").run(fmt::format("sum SegmentedVector iterator: {}", size), [&] {
+            int sum = 0;
+
+            for (const auto i : vec)
+                sum += i;
+
+            ankerl::nanobench::doNotOptimizeAway(sum);
+        });
+
+        ankerl::nanobench::Bench().batch(size).unit("value").run(fmt::format("sum SegmentedVector segments: {}", size), [&] {
+            int sum = 0;
+
+            for (auto it = vec.cbegin(); it != vec.cend();) {
+                const auto count = std::min(it.segment_remaining(), vec.cend() - it);
+
+                for (const int* p = it.base(); p != it.base() + count; ++p)
+                    sum += *p;
+
+                it += count;
+            }
+
+            ankerl::nanobench::doNotOptimizeAway(sum);
+        });
+
+        ankerl::nanobench::Bench().batch(size).unit("value").run(fmt::format("sum SegmentedVector segmented_accumulate(): {}", size), [&] {
+            ankerl::nanobench::doNotOptimizeAway(segmented_accumulate(vec.cbegin(), vec.cend(), 0));
+        });
+    }
+}
+
+// fills a buffer that has to be resized first, like a read() into the end of a vector
+void benchmark_fill_buffer()
+{
+    for (auto size : {1024, 1 << 20}) {
+        const std::vector<char> source(static_cast<std::size_t>(size), 'x');
+
+        ankerl::nanobench::Bench().batch(size).unit("byte").run(fmt::format("fill buffer resize: {}", size), [&] {
+            CustomVector<char> buffer;
+            buffer.resize(source.size());
+            std::memcpy(buffer.data(), source.data(), source.size());
+            ankerl::nanobench::doNotOptimizeAway(buffer.data());
+        });
+
+        ankerl::nanobench::Bench().batch(size).unit("byte").run(fmt::format("fill buffer resize_uninitialized: {}", size), [&] {
+            CustomVector<char> buffer;
+            buffer.resize_uninitialized(source.size());
+            std::memcpy(buffer.data(), source.data(), source.size());
+            ankerl::nanobench::doNotOptimizeAway(buffer.data());
+        });
+
+        ankerl::nanobench::Bench().batch(size).unit("byte").run(fmt::format("fill buffer append_uninitialized: {}", size), [&] {
+            CustomVector<char> buffer;
+
+            for (std::size_t offset = 0; offset < source.size(); offset += 256) {
+                const auto chunk = buffer.append_uninitialized(256);
+                std::memcpy(chunk.data(), source.data() + offset, chunk.size());
+            }
+
+            ankerl::nanobench::doNotOptimizeAway(buffer.data());
+        });
+    }
+}
+
+int main()
+{
+    benchmark_push_back_ints<std::vector<int>>("std::vector");
+    benchmark_push_back_ints<CustomVector<int>>("CustomVector 3/2");
+    benchmark_push_back_ints<CustomVector<int, std::allocator<int>, std::ratio<2, 1>>>("CustomVector 2");
+    benchmark_push_back_ints<SegmentedVector<int>>("SegmentedVector");
+
+    benchmark_push_back_ints_reserved<std::vector<int>>("std::vector");
+    benchmark_push_back_ints_reserved<CustomVector<int>>("CustomVector");
+    benchmark_push_back_ints_reserved<SegmentedVector<int>>("SegmentedVector");
+
+    benchmark_push_back_strings<std::vector<std::string>>("std::vector");
+    benchmark_push_back_strings<CustomVector<std::string>>("CustomVector 3/2");
+    benchmark_push_back_strings<CustomVector<std::string, std::allocator<std::string>, std::ratio<2, 1>>>("CustomVector 2");
+
+    benchmark_small_vectors<std::vector<int>>("std::vector");
+    benchmark_small_vectors<CustomVector<int>>("CustomVector");
+    benchmark_small_vectors<SmallVector<int, 16>>("SmallVector<16>");
+
+    benchmark_sum_segmented_vector();
+    benchmark_fill_buffer();
+}
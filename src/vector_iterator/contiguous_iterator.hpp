@@ -0,0 +1,79 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// Random access iterator over values stored next to each other, used by CustomVector and SmallVector.
+template <typename pointer, typename reference>
+class ContiguousIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::contiguous_iterator_tag;
+    using value_type = std::remove_cv_t<std::remove_pointer_t<pointer>>;
+    using difference_type = std::ptrdiff_t;
+
+    ContiguousIterator() : ptr_{} { }
+    explicit ContiguousIterator(pointer ptr) : ptr_{ptr} { }
+
+    // iterator to const_iterator
+    template <typename OtherPointer, typename OtherReference>
+        requires std::is_convertible_v<OtherPointer, pointer>
+    ContiguousIterator(const ContiguousIterator<OtherPointer, OtherReference>& other) : ptr_{other.base()} { }
+
+    reference operator*() const { return *ptr_; }
+    pointer operator->() const { return ptr_; }
+
+    pointer base() const { return ptr_; }
+
+    ContiguousIterator& operator++()
+    {
+        ++ptr_;
+        return *this;
+    }
+
+    ContiguousIterator operator++(int)
+    {
+        const ContiguousIterator tmp{*this};
+        ++(*this);
+        return tmp;
+    }
+
+    ContiguousIterator& operator--()
+    {
+        --ptr_;
+        return *this;
+    }
+
+    ContiguousIterator operator--(int)
+    {
+        const ContiguousIterator tmp{*this};
+        --(*this);
+        return tmp;
+    }
+
+    ContiguousIterator& operator+=(const difference_type off)
+    {
+        ptr_ += off;
+        return *this;
+    }
+
+    ContiguousIterator& operator-=(const difference_type off)
+    {
+        ptr_ -= off;
+        return *this;
+    }
+
+    ContiguousIterator operator+(const difference_type off) const { return ContiguousIterator{ptr_ + off}; }
+    ContiguousIterator operator-(const difference_type off) const { return ContiguousIterator{ptr_ - off}; }
+    friend ContiguousIterator operator+(const difference_type off, const ContiguousIterator& a) { return ContiguousIterator{a.ptr_ + off}; }
+    friend difference_type operator-(const ContiguousIterator& a, const ContiguousIterator& b) { return a.ptr_ - b.ptr_; };
+
+    reference operator[](const difference_type off) const { return *(ptr_ + off); }
+
+    auto operator<=>(const ContiguousIterator&) const = default;
+
+private:
+    pointer ptr_;
+};
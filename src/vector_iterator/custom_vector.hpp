@@ -1,98 +1,81 @@
 #pragma once
 
-#include <compare>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
 #include <iterator>
-#include <vector>
+#include <memory>
+#include <memory_resource>
+#include <ratio>
+#include <span>
+#include <type_traits>
+#include <utility>
 
-template <typename T>
-class CustomVector {
-private:
-    template <typename pointer, typename reference>
-    class Iterator {
-    public:
-        using iterator_category = std::random_access_iterator_tag;
-        using value_type = T;
-        using difference_type = std::ptrdiff_t;
-
-        Iterator() : ptr_{} { }
-        explicit Iterator(pointer ptr) : ptr_{ptr} { }
-
-        reference operator*() const { return *ptr_; }
-        pointer operator->() const { return ptr_; }
-
-        Iterator& operator++()
-        {
-            ++ptr_;
-            return *this;
-        }
-
-        Iterator operator++(int)
-        {
-            const Iterator tmp{*this};
-            ++(*this);
-            return tmp;
-        }
-
-        Iterator& operator--()
-        {
-            --ptr_;
-            return *this;
-        }
-
-        Iterator operator--(int)
-        {
-            const Iterator tmp{*this};
-            --(*this);
-            return tmp;
-        }
-
-        Iterator& operator+=(const difference_type off)
-        {
-            ptr_ += off;
-            return *this;
-        }
-
-        Iterator& operator-=(const difference_type off)
-        {
-            ptr_ -= off;
-            return *this;
-        }
-
-        Iterator operator+(const difference_type off) const { return Iterator{ptr_ + off}; }
-        Iterator operator-(const difference_type off) const { return Iterator{ptr_ - off}; }
-        friend Iterator operator+(const difference_type off, const Iterator& a) { return Iterator{a.ptr_ + off}; }
-        friend difference_type operator-(const Iterator& a, const Iterator& b) { return a.ptr_ - b.ptr_; };
+#include "contiguous_iterator.hpp"
+#include "relocate.hpp"
 
-        reference operator[](const difference_type off) const { return *(ptr_ + off); }
+// Tag for constructors that default-initialize their values, leaving values of types like int indeterminate.
+struct ForOverwrite { };
+inline constexpr ForOverwrite for_overwrite{};
 
-        auto operator<=>(const Iterator&) const = default;
+// A vector with its own storage. GrowthFactor (a std::ratio, 3/2 by default) sets how much the capacity grows
+// when it runs out, a factor below 2 lets freed blocks be reused by later, larger allocations.
+// Reallocating moves trivially relocatable values with a single memcpy.
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthFactor = std::ratio<3, 2>>
+class CustomVector {
+private:
+    static_assert(GrowthFactor::num > GrowthFactor::den, "the growth factor has to be larger than 1");
 
-    private:
-        pointer ptr_;
-    };
+    using alloc_traits = std::allocator_traits<Allocator>;
 
 public:
+    using value_type = T;
     using pointer = T*;
     using reference = T&;
     using const_pointer = const T*;
     using const_reference = const T&;
     using size_type = std::size_t;
-    using iterator = Iterator<pointer, reference>;
-    using const_iterator = Iterator<const_pointer, const_reference>;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type = Allocator;
+    using growth_factor = GrowthFactor;
+    using iterator = ContiguousIterator<pointer, reference>;
+    using const_iterator = ContiguousIterator<const_pointer, const_reference>;
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
-    CustomVector() : vector_{} { }
-    explicit CustomVector(std::initializer_list<T> init) : vector_{init} { }
+    CustomVector() : CustomVector(Allocator{}) { }
+    explicit CustomVector(const Allocator& alloc) : alloc_{alloc} { }
+    explicit CustomVector(size_type count, const Allocator& alloc = Allocator{});
+    CustomVector(size_type count, const T& value, const Allocator& alloc = Allocator{});
+    CustomVector(size_type count, ForOverwrite, const Allocator& alloc = Allocator{});
+    explicit CustomVector(std::initializer_list<T> init, const Allocator& alloc = Allocator{});
+
+    template <std::forward_iterator It>
+    CustomVector(It first, It last, const Allocator& alloc = Allocator{});
+
+    CustomVector(const CustomVector& other);
+    CustomVector(CustomVector&& other) noexcept;
+    ~CustomVector();
+
+    CustomVector& operator=(const CustomVector& other);
+    CustomVector& operator=(CustomVector&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value);
+
+    allocator_type get_allocator() const { return alloc_; }
+
+    size_type size() const { return static_cast<size_type>(end_ - begin_); }
+    size_type capacity() const { return static_cast<size_type>(capacity_end_ - begin_); }
+    [[nodiscard]] bool empty() const { return begin_ == end_; }
 
-    size_type size() const { return vector_.size(); }
+    pointer data() { return begin_; }
+    const_pointer data() const { return begin_; }
 
-    iterator begin() { return iterator{vector_.data()}; }
-    const_iterator begin() const { return const_iterator{vector_.data()}; }
+    iterator begin() { return iterator{begin_}; }
+    const_iterator begin() const { return const_iterator{begin_}; }
     const_iterator cbegin() const { return begin(); }
 
-    iterator end() { return iterator{vector_.data() + vector_.size()}; }
-    const_iterator end() const { return const_iterator{vector_.data() + vector_.size()}; }
+    iterator end() { return iterator{end_}; }
+    const_iterator end() const { return const_iterator{end_}; }
     const_iterator cend() const { return end(); }
 
     reverse_iterator rbegin() { return reverse_iterator{end()}; }
@@ -103,9 +86,520 @@ public:
     const_reverse_iterator rend() const { return const_reverse_iterator{begin()}; }
     const_reverse_iterator crend() const { return rend(); }
 
-    reference operator[](const size_type pos) { return vector_[pos]; }
-    const_reference operator[](const size_type pos) const { return vector_[pos]; }
+    reference operator[](const size_type pos)
+    {
+        assert(pos < size());
+        return begin_[pos];
+    }
+
+    const_reference operator[](const size_type pos) const
+    {
+        assert(pos < size());
+        return begin_[pos];
+    }
+
+    reference front() { return (*this)[0]; }
+    const_reference front() const { return (*this)[0]; }
+
+    reference back() { return (*this)[size() - 1]; }
+    const_reference back() const { return (*this)[size() - 1]; }
+
+    void reserve(size_type new_capacity);
+    void shrink_to_fit();
+    void clear();
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    reference emplace_back(Args&&... args);
+
+    void pop_back();
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+
+    iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+    iterator insert(const_iterator pos, size_type count, const T& value);
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+    iterator erase(const_iterator first, const_iterator last);
+
+    void resize(size_type count);
+    void resize(size_type count, const T& value);
+
+    // Like resize(), but new values of trivially default constructible types are left uninitialized instead of
+    // being zeroed, for buffers that are overwritten right away, for example by read() or a SIMD kernel.
+    void resize_default_init(size_type count);
+
+    // resize_default_init() for types whose default initialization does nothing, which are the only ones allowed,
+    // so it never runs constructors and never leaves objects half-constructed.
+    void resize_uninitialized(size_type count)
+        requires std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>;
+
+    // Appends count values with indeterminate contents and returns them, they have to be written before they are
+    // read. Grows the capacity like push_back(), so repeated appends stay amortized O(1) per value.
+    [[nodiscard]] std::span<T> append_uninitialized(size_type count)
+        requires std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>;
+
+    void swap(CustomVector& other) noexcept;
+
+    friend bool operator==(const CustomVector& a, const CustomVector& b) { return std::equal(a.begin(), a.end(), b.begin(), b.end()); }
 
 private:
-    std::vector<T> vector_;
+    [[no_unique_address]] Allocator alloc_;
+    pointer begin_ = nullptr;
+    pointer end_ = nullptr;
+    pointer capacity_end_ = nullptr;
+
+    // capacity for at least required values, growing by the growth factor
+    [[nodiscard]] size_type grown_capacity(size_type required) const;
+
+    // moves all values into a new buffer of the given capacity
+    void reallocate(size_type new_capacity);
+
+    // constructs the value at pos of a new, larger buffer and then moves the other values around it
+    template <typename... Args>
+    pointer reallocate_and_emplace(pointer pos, Args&&... args);
+
+    template <typename... Args>
+    void construct_at_end(size_type count, const Args&... args);
+
+    void default_construct_at_end(size_type count);
+
+    void deallocate();
 };
+
+template <typename T>
+using PmrCustomVector = CustomVector<T, std::pmr::polymorphic_allocator<T>>;
+
+template <typename T, typename Allocator, typename GrowthFactor>
+CustomVector<T, Allocator, GrowthFactor>::CustomVector(const size_type count, const Allocator& alloc) : CustomVector(alloc)
+{
+    reserve(count);
+    construct_at_end(count);
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+CustomVector<T, Allocator, GrowthFactor>::CustomVector(const size_type count, const T& value, const Allocator& alloc) : CustomVector(alloc)
+{
+    reserve(count);
+    construct_at_end(count, value);
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+CustomVector<T, Allocator, GrowthFactor>::CustomVector(const size_type count, ForOverwrite, const Allocator& alloc) : CustomVector(alloc)
+{
+    reserve(count);
+    default_construct_at_end(count);
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+CustomVector<T, Allocator, GrowthFactor>::CustomVector(const std::initializer_list<T> init, const Allocator& alloc) : CustomVector(init.begin(), init.end(), alloc)
+{
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+template <std::forward_iterator It>
+CustomVector<T, Allocator, GrowthFactor>::CustomVector(It first, const It last, const Allocator& alloc) : CustomVector(alloc)
+{
+    reserve(static_cast<size_type>(std::distance(first, last)));
+
+    for (; first != last; ++first) {
+        alloc_traits::construct(alloc_, end_, *first);
+        ++end_;
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+CustomVector<T, Allocator, GrowthFactor>::CustomVector(const CustomVector& other) : CustomVector(other.begin(), other.end(), alloc_traits::select_on_container_copy_construction(other.alloc_))
+{
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+CustomVector<T, Allocator, GrowthFactor>::CustomVector(CustomVector&& other) noexcept
+    : alloc_{std::move(other.alloc_)}, begin_{std::exchange(other.begin_, nullptr)}, end_{std::exchange(other.end_, nullptr)}, capacity_end_{std::exchange(other.capacity_end_, nullptr)}
+{
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+CustomVector<T, Allocator, GrowthFactor>::~CustomVector()
+{
+    clear();
+    deallocate();
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+CustomVector<T, Allocator, GrowthFactor>& CustomVector<T, Allocator, GrowthFactor>::operator=(const CustomVector& other)
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+        if (alloc_ != other.alloc_)
+            deallocate();
+
+        alloc_ = other.alloc_;
+    }
+
+    reserve(other.size());
+
+    for (const T& value : other) {
+        alloc_traits::construct(alloc_, end_, value);
+        ++end_;
+    }
+
+    return *this;
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+CustomVector<T, Allocator, GrowthFactor>& CustomVector<T, Allocator, GrowthFactor>::operator=(CustomVector&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+
+    // memory from another allocator (like another memory resource) cannot be taken over, only the values
+    if constexpr (!alloc_traits::propagate_on_container_move_assignment::value) {
+        if (alloc_ != other.alloc_) {
+            reserve(other.size());
+
+            for (T& value : other) {
+                alloc_traits::construct(alloc_, end_, std::move(value));
+                ++end_;
+            }
+
+            other.clear();
+            return *this;
+        }
+    }
+
+    deallocate();
+
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        alloc_ = std::move(other.alloc_);
+
+    begin_ = std::exchange(other.begin_, nullptr);
+    end_ = std::exchange(other.end_, nullptr);
+    capacity_end_ = std::exchange(other.capacity_end_, nullptr);
+    return *this;
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+void CustomVector<T, Allocator, GrowthFactor>::reserve(const size_type new_capacity)
+{
+    if (new_capacity > capacity())
+        reallocate(new_capacity);
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+void CustomVector<T, Allocator, GrowthFactor>::shrink_to_fit()
+{
+    if (capacity() == size())
+        return;
+
+    if (empty())
+        deallocate();
+    else
+        reallocate(size());
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+void CustomVector<T, Allocator, GrowthFactor>::clear()
+{
+    destroy_values(alloc_, begin_, end_);
+    end_ = begin_;
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+template <typename... Args>
+typename CustomVector<T, Allocator, GrowthFactor>::reference CustomVector<T, Allocator, GrowthFactor>::emplace_back(Args&&... args)
+{
+    if (end_ == capacity_end_)
+        return *reallocate_and_emplace(end_, std::forward<Args>(args)...);
+
+    alloc_traits::construct(alloc_, end_, std::forward<Args>(args)...);
+    return *end_++;
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+void CustomVector<T, Allocator, GrowthFactor>::pop_back()
+{
+    assert(!empty());
+    alloc_traits::destroy(alloc_, --end_);
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+template <typename... Args>
+typename CustomVector<T, Allocator, GrowthFactor>::iterator CustomVector<T, Allocator, GrowthFactor>::emplace(const const_iterator pos, Args&&... args)
+{
+    const auto p = const_cast<pointer>(pos.base());
+    assert(p >= begin_ && p <= end_);
+
+    if (end_ == capacity_end_)
+        return iterator{reallocate_and_emplace(p, std::forward<Args>(args)...)};
+
+    if (p == end_) {
+        alloc_traits::construct(alloc_, end_, std::forward<Args>(args)...);
+        ++end_;
+        return iterator{p};
+    }
+
+    // args could refer to a value of the vector that is about to move
+    T value(std::forward<Args>(args)...);
+    alloc_traits::construct(alloc_, end_, std::move(end_[-1]));
+    ++end_;
+    std::move_backward(p, end_ - 2, end_ - 1);
+    *p = std::move(value);
+    return iterator{p};
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+typename CustomVector<T, Allocator, GrowthFactor>::iterator CustomVector<T, Allocator, GrowthFactor>::insert(const const_iterator pos, const size_type count, const T& value)
+{
+    const auto offset = pos.base() - begin_;
+    assert(offset >= 0 && offset <= end_ - begin_);
+
+    if (count == 0)
+        return iterator{begin_ + offset};
+
+    // value could be an element of the vector
+    const T copy(value);
+
+    if (size() + count > capacity())
+        reallocate(grown_capacity(size() + count));
+
+    const pointer p = begin_ + offset;
+    const auto tail = static_cast<size_type>(end_ - p);
+    const pointer old_end = end_;
+
+    if (tail > count) {
+        // the last count values move into uninitialized memory, the rest of the tail moves back by count
+        for (pointer src = old_end - count; src != old_end; ++src) {
+            alloc_traits::construct(alloc_, end_, std::move(*src));
+            ++end_;
+        }
+
+        std::move_backward(p, old_end - count, old_end);
+        std::fill_n(p, count, copy);
+    } else {
+        // the new values reach into uninitialized memory, followed by the whole tail
+        construct_at_end(count - tail, copy);
+
+        for (pointer src = p; src != old_end; ++src) {
+            alloc_traits::construct(alloc_, end_, std::move(*src));
+            ++end_;
+        }
+
+        std::fill(p, old_end, copy);
+    }
+
+    return iterator{p};
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+typename CustomVector<T, Allocator, GrowthFactor>::iterator CustomVector<T, Allocator, GrowthFactor>::erase(const const_iterator first, const const_iterator last)
+{
+    const auto p = const_cast<pointer>(first.base());
+    const auto q = const_cast<pointer>(last.base());
+    assert(begin_ <= p && p <= q && q <= end_);
+
+    if (p != q) {
+        const pointer new_end = std::move(q, end_, p);
+        destroy_values(alloc_, new_end, end_);
+        end_ = new_end;
+    }
+
+    return iterator{p};
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+void CustomVector<T, Allocator, GrowthFactor>::resize(const size_type count)
+{
+    if (count < size()) {
+        destroy_values(alloc_, begin_ + count, end_);
+        end_ = begin_ + count;
+    } else {
+        if (count > capacity())
+            reallocate(grown_capacity(count));
+
+        construct_at_end(count - size());
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+void CustomVector<T, Allocator, GrowthFactor>::resize(const size_type count, const T& value)
+{
+    if (count < size()) {
+        destroy_values(alloc_, begin_ + count, end_);
+        end_ = begin_ + count;
+    } else {
+        const T copy(value);
+
+        if (count > capacity())
+            reallocate(grown_capacity(count));
+
+        construct_at_end(count - size(), copy);
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+void CustomVector<T, Allocator, GrowthFactor>::resize_default_init(const size_type count)
+{
+    if (count < size()) {
+        destroy_values(alloc_, begin_ + count, end_);
+        end_ = begin_ + count;
+    } else {
+        if (count > capacity())
+            reallocate(grown_capacity(count));
+
+        default_construct_at_end(count - size());
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+void CustomVector<T, Allocator, GrowthFactor>::resize_uninitialized(const size_type count)
+    requires std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>
+{
+    if (count > capacity())
+        reallocate(grown_capacity(count));
+
+    end_ = begin_ + count;
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+std::span<T> CustomVector<T, Allocator, GrowthFactor>::append_uninitialized(const size_type count)
+    requires std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>
+{
+    if (size() + count > capacity())
+        reallocate(grown_capacity(size() + count));
+
+    const pointer first = end_;
+    end_ += count;
+    return {first, count};
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+void CustomVector<T, Allocator, GrowthFactor>::swap(CustomVector& other) noexcept
+{
+    if constexpr (alloc_traits::propagate_on_container_swap::value)
+        std::swap(alloc_, other.alloc_);
+    else
+        assert(alloc_ == other.alloc_);
+
+    std::swap(begin_, other.begin_);
+    std::swap(end_, other.end_);
+    std::swap(capacity_end_, other.capacity_end_);
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+typename CustomVector<T, Allocator, GrowthFactor>::size_type CustomVector<T, Allocator, GrowthFactor>::grown_capacity(const size_type required) const
+{
+    const size_type grown = capacity() * GrowthFactor::num / GrowthFactor::den;
+    return std::max({required, grown, size_type{4}});
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+void CustomVector<T, Allocator, GrowthFactor>::reallocate(const size_type new_capacity)
+{
+    assert(new_capacity >= size());
+
+    const size_type count = size();
+    const pointer new_begin = alloc_traits::allocate(alloc_, new_capacity);
+
+    try {
+        relocate_values(alloc_, begin_, end_, new_begin);
+    } catch (...) {
+        alloc_traits::deallocate(alloc_, new_begin, new_capacity);
+        throw;
+    }
+
+    deallocate();
+    begin_ = new_begin;
+    end_ = new_begin + count;
+    capacity_end_ = new_begin + new_capacity;
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+template <typename... Args>
+typename CustomVector<T, Allocator, GrowthFactor>::pointer CustomVector<T, Allocator, GrowthFactor>::reallocate_and_emplace(const pointer pos, Args&&... args)
+{
+    const auto offset = pos - begin_;
+    const size_type count = size();
+    const size_type new_capacity = grown_capacity(count + 1);
+    const pointer new_begin = alloc_traits::allocate(alloc_, new_capacity);
+    const pointer new_pos = new_begin + offset;
+
+    // construct first, args could refer to a value of the vector
+    try {
+        alloc_traits::construct(alloc_, new_pos, std::forward<Args>(args)...);
+    } catch (...) {
+        alloc_traits::deallocate(alloc_, new_begin, new_capacity);
+        throw;
+    }
+
+    try {
+        relocate_values(alloc_, begin_, pos, new_begin);
+
+        try {
+            relocate_values(alloc_, pos, end_, new_pos + 1);
+        } catch (...) {
+            // move the first part back, so the vector is unchanged
+            relocate_values(alloc_, new_begin, new_pos, begin_);
+            throw;
+        }
+    } catch (...) {
+        alloc_traits::destroy(alloc_, new_pos);
+        alloc_traits::deallocate(alloc_, new_begin, new_capacity);
+        throw;
+    }
+
+    deallocate();
+    begin_ = new_begin;
+    end_ = new_begin + count + 1;
+    capacity_end_ = new_begin + new_capacity;
+    return new_pos;
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+template <typename... Args>
+void CustomVector<T, Allocator, GrowthFactor>::construct_at_end(const size_type count, const Args&... args)
+{
+    assert(count <= static_cast<size_type>(capacity_end_ - end_));
+
+    for (size_type i = 0; i < count; ++i) {
+        alloc_traits::construct(alloc_, end_, args...);
+        ++end_;
+    }
+}
+
+// the allocator cannot default-initialize, allocator_traits::construct() always value-initializes
+template <typename T, typename Allocator, typename GrowthFactor>
+void CustomVector<T, Allocator, GrowthFactor>::default_construct_at_end(const size_type count)
+{
+    assert(count <= static_cast<size_type>(capacity_end_ - end_));
+
+    if constexpr (std::is_trivially_default_constructible_v<T>) {
+        end_ += count;
+    } else {
+        for (size_type i = 0; i < count; ++i) {
+            alloc_traits::construct(alloc_, end_);
+            ++end_;
+        }
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthFactor>
+void CustomVector<T, Allocator, GrowthFactor>::deallocate()
+{
+    if (begin_)
+        alloc_traits::deallocate(alloc_, begin_, capacity());
+
+    begin_ = nullptr;
+    end_ = nullptr;
+    capacity_end_ = nullptr;
+}
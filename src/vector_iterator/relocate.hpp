@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Types whose objects can be moved to another address with memcpy, without calling the move constructor and
+// destructor. True for trivially copyable types, specialize it for others like types holding a std::unique_ptr.
+template <typename T>
+struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_copyable_v<T>> { };
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = IsTriviallyRelocatable<T>::value;
+
+template <typename Allocator, typename T>
+void destroy_values(Allocator& alloc, T* first, T* last)
+{
+    if constexpr (!std::is_trivially_destructible_v<T>)
+        for (T* p = first; p != last; ++p)
+            std::allocator_traits<Allocator>::destroy(alloc, p);
+}
+
+// Moves the values of [first, last) to uninitialized memory at dest, leaving [first, last) destroyed.
+// Copies if moving could throw and T is copyable, so an exception leaves the values unchanged.
+template <typename Allocator, typename T>
+void relocate_values(Allocator& alloc, T* first, T* last, T* dest)
+{
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (first != last)
+            std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), static_cast<std::size_t>(last - first) * sizeof(T));
+    } else {
+        T* constructed = dest;
+
+        try {
+            for (T* src = first; src != last; ++src, ++constructed)
+                std::allocator_traits<Allocator>::construct(alloc, constructed, std::move_if_noexcept(*src));
+        } catch (...) {
+            destroy_values(alloc, dest, constructed);
+            throw;
+        }
+
+        destroy_values(alloc, first, last);
+    }
+}
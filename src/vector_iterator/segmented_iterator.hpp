@@ -0,0 +1,104 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// Random access iterator over values stored in blocks of SegmentSize (a power of two) values, used by
+// SegmentedVector. The values in [base(), base() + segment_remaining()) are contiguous, so algorithms can process
+// a whole segment with a tight loop over raw pointers instead of going through the iterator for every value.
+template <typename pointer, typename reference, std::size_t SegmentSize>
+class SegmentedIterator {
+public:
+    static_assert(std::has_single_bit(SegmentSize), "the segment size has to be a power of two");
+
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<std::remove_pointer_t<pointer>>;
+    using difference_type = std::ptrdiff_t;
+
+    static constexpr std::size_t segment_size = SegmentSize;
+
+    SegmentedIterator() : segments_{}, index_{} { }
+    SegmentedIterator(const pointer* segments, const difference_type index) : segments_{segments}, index_{index} { }
+
+    // iterator to const_iterator
+    template <typename OtherPointer, typename OtherReference>
+        requires std::is_convertible_v<OtherPointer, pointer>
+    SegmentedIterator(const SegmentedIterator<OtherPointer, OtherReference, SegmentSize>& other) : segments_{other.segments()}, index_{other.index()} { }
+
+    reference operator*() const { return *base(); }
+    pointer operator->() const { return base(); }
+
+    // the value in its segment, only for dereferenceable iterators
+    pointer base() const
+    {
+        assert(index_ >= 0);
+        return segments_[index_ >> shift] + (index_ & mask);
+    }
+
+    // number of values from here to the end of the segment
+    difference_type segment_remaining() const { return segment_offset - (index_ & mask); }
+
+    const pointer* segments() const { return segments_; }
+    difference_type index() const { return index_; }
+
+    SegmentedIterator& operator++()
+    {
+        ++index_;
+        return *this;
+    }
+
+    SegmentedIterator operator++(int)
+    {
+        const SegmentedIterator tmp{*this};
+        ++(*this);
+        return tmp;
+    }
+
+    SegmentedIterator& operator--()
+    {
+        --index_;
+        return *this;
+    }
+
+    SegmentedIterator operator--(int)
+    {
+        const SegmentedIterator tmp{*this};
+        --(*this);
+        return tmp;
+    }
+
+    SegmentedIterator& operator+=(const difference_type off)
+    {
+        index_ += off;
+        return *this;
+    }
+
+    SegmentedIterator& operator-=(const difference_type off)
+    {
+        index_ -= off;
+        return *this;
+    }
+
+    SegmentedIterator operator+(const difference_type off) const { return SegmentedIterator{segments_, index_ + off}; }
+    SegmentedIterator operator-(const difference_type off) const { return SegmentedIterator{segments_, index_ - off}; }
+    friend SegmentedIterator operator+(const difference_type off, const SegmentedIterator& a) { return SegmentedIterator{a.segments_, a.index_ + off}; }
+    friend difference_type operator-(const SegmentedIterator& a, const SegmentedIterator& b) { return a.index_ - b.index_; };
+
+    reference operator[](const difference_type off) const { return *(*this + off); }
+
+    // iterators of the same vector share the segment table, the index orders them
+    friend bool operator==(const SegmentedIterator& a, const SegmentedIterator& b) { return a.index_ == b.index_; }
+    friend std::strong_ordering operator<=>(const SegmentedIterator& a, const SegmentedIterator& b) { return a.index_ <=> b.index_; }
+
+private:
+    static constexpr int shift = std::countr_zero(SegmentSize);
+    static constexpr auto segment_offset = static_cast<difference_type>(SegmentSize);
+    static constexpr difference_type mask = segment_offset - 1;
+
+    const pointer* segments_;
+    difference_type index_;
+};
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include "custom_vector.hpp"
+#include "relocate.hpp"
+#include "segmented_iterator.hpp"
+
+// about 4 KB per segment, at least 16 values
+template <typename T>
+inline constexpr std::size_t default_segment_size = std::max(std::size_t{16}, std::bit_floor(4096 / sizeof(T)));
+
+// A vector that stores its values in segments of SegmentSize (a power of two) values. Growing allocates a new
+// segment and never moves values, so pointers and references to them stay valid until they are removed.
+// Iterators are invalidated by growing, because the table of segments can move. operator[] is two shifts/masks and
+// two loads, algorithms can use SegmentedIterator::segment_remaining() to loop over a segment at a time.
+template <typename T, std::size_t SegmentSize = default_segment_size<T>, typename Allocator = std::allocator<T>>
+class SegmentedVector {
+private:
+    static_assert(std::has_single_bit(SegmentSize), "the segment size has to be a power of two");
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+    using SegmentTable = CustomVector<T*, typename alloc_traits::template rebind_alloc<T*>>;
+
+public:
+    using value_type = T;
+    using pointer = T*;
+    using reference = T&;
+    using const_pointer = const T*;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type = Allocator;
+    using iterator = SegmentedIterator<pointer, reference, SegmentSize>;
+    using const_iterator = SegmentedIterator<const_pointer, const_reference, SegmentSize>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr size_type segment_size = SegmentSize;
+
+    SegmentedVector() : SegmentedVector(Allocator{}) { }
+    explicit SegmentedVector(const Allocator& alloc) : alloc_{alloc}, segments_{typename SegmentTable::allocator_type{alloc}} { }
+    SegmentedVector(size_type count, const T& value, const Allocator& alloc = Allocator{});
+    explicit SegmentedVector(std::initializer_list<T> init, const Allocator& alloc = Allocator{});
+
+    template <std::forward_iterator It>
+    SegmentedVector(It first, It last, const Allocator& alloc = Allocator{});
+
+    SegmentedVector(const SegmentedVector& other);
+    SegmentedVector(SegmentedVector&& other) noexcept;
+    ~SegmentedVector();
+
+    SegmentedVector& operator=(const SegmentedVector& other);
+    SegmentedVector& operator=(SegmentedVector&& other);
+
+    allocator_type get_allocator() const { return alloc_; }
+
+    size_type size() const { return size_; }
+    size_type capacity() const { return segments_.size() * SegmentSize; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+
+    iterator begin() { return iterator{segments_.data(), 0}; }
+    const_iterator begin() const { return const_iterator{segments_.data(), 0}; }
+    const_iterator cbegin() const { return begin(); }
+
+    iterator end() { return iterator{segments_.data(), static_cast<difference_type>(size_)}; }
+    const_iterator end() const { return const_iterator{segments_.data(), static_cast<difference_type>(size_)}; }
+    const_iterator cend() const { return end(); }
+
+    reverse_iterator rbegin() { return reverse_iterator{end()}; }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator{end()}; }
+    const_reverse_iterator crbegin() const { return rbegin(); }
+
+    reverse_iterator rend() { return reverse_iterator{begin()}; }
+    const_reverse_iterator rend() const { return const_reverse_iterator{begin()}; }
+    const_reverse_iterator crend() const { return rend(); }
+
+    reference operator[](const size_type pos)
+    {
+        assert(pos < size_);
+        return segments_[pos >> shift][pos & mask];
+    }
+
+    const_reference operator[](const size_type pos) const
+    {
+        assert(pos < size_);
+        return segments_[pos >> shift][pos & mask];
+    }
+
+    reference front() { return (*this)[0]; }
+    const_reference front() const { return (*this)[0]; }
+
+    reference back() { return (*this)[size_ - 1]; }
+    const_reference back() const { return (*this)[size_ - 1]; }
+
+    // allocates segments for at least new_capacity values
+    void reserve(size_type new_capacity);
+
+    // frees the segments that hold no values
+    void shrink_to_fit();
+
+    // destroys all values and keeps the segments
+    void clear();
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    reference emplace_back(Args&&... args);
+
+    void pop_back();
+
+    void resize(size_type count);
+    void resize(size_type count, const T& value);
+
+    friend bool operator==(const SegmentedVector& a, const SegmentedVector& b) { return std::equal(a.begin(), a.end(), b.begin(), b.end()); }
+
+private:
+    static constexpr int shift = std::countr_zero(SegmentSize);
+    static constexpr size_type mask = SegmentSize - 1;
+
+    [[no_unique_address]] Allocator alloc_;
+    SegmentTable segments_;
+    size_type size_ = 0;
+
+    void add_segment();
+    void deallocate();
+};
+
+template <typename T, std::size_t SegmentSize = default_segment_size<T>>
+using PmrSegmentedVector = SegmentedVector<T, SegmentSize, std::pmr::polymorphic_allocator<T>>;
+
+template <typename T, std::size_t SegmentSize, typename Allocator>
+SegmentedVector<T, SegmentSize, Allocator>::SegmentedVector(const size_type count, const T& value, const Allocator& alloc) : SegmentedVector(alloc)
+{
+    resize(count, value);
+}
+
+template <typename T, std::size_t SegmentSize, typename Allocator>
+SegmentedVector<T, SegmentSize, Allocator>::SegmentedVector(const std::initializer_list<T> init, const Allocator& alloc) : SegmentedVector(init.begin(), init.end(), alloc)
+{
+}
+
+template <typename T, std::size_t SegmentSize, typename Allocator>
+template <std::forward_iterator It>
+SegmentedVector<T, SegmentSize, Allocator>::SegmentedVector(It first, const It last, const Allocator& alloc) : SegmentedVector(alloc)
+{
+    reserve(static_cast<size_type>(std::distance(first, last)));
+
+    for (; first != last; ++first)
+        emplace_back(*first);
+}
+
+template <typename T, std::size_t SegmentSize, typename Allocator>
+SegmentedVector<T, SegmentSize, Allocator>::SegmentedVector(const SegmentedVector& other) : SegmentedVector(other.begin(), other.end(), alloc_traits::select_on_container_copy_construction(other.alloc_))
+{
+}
+
+template <typename T, std::size_t SegmentSize, typename Allocator>
+SegmentedVector<T, SegmentSize, Allocator>::SegmentedVector(SegmentedVector&& other) noexcept
+    : alloc_{std::move(other.alloc_)}, segments_{std::move(other.segments_)}, size_{std::exchange(other.size_, 0)}
+{
+}
+
+template <typename T, std::size_t SegmentSize, typename Allocator>
+SegmentedVector<T, SegmentSize, Allocator>::~SegmentedVector()
+{
+    clear();
+    deallocate();
+}
+
+template <typename T, std::size_t SegmentSize, typename Allocator>
+SegmentedVector<T, SegmentSize, Allocator>& SegmentedVector<T, SegmentSize, Allocator>::operator=(const SegmentedVector& other)
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+        if (alloc_ != other.alloc_)
+            deallocate();
+
+        alloc_ = other.alloc_;
+    }
+
+    reserve(other.size());
+
+    for (const T& value : other)
+        emplace_back(value);
+
+    return *this;
+}
+
+template <typename T, std::size_t SegmentSize, typename Allocator>
+SegmentedVector<T, SegmentSize, Allocator>& SegmentedVector<T, SegmentSize, Allocator>::operator=(SegmentedVector&& other)
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+
+    // segments from another allocator (like another memory resource) cannot be taken over, only the values
+    if constexpr (!alloc_traits::propagate_on_container_move_assignment::value) {
+        if (alloc_ != other.alloc_) {
+            reserve(other.size());
+
+            for (T& value : other)
+                emplace_back(std::move(value));
+
+            other.clear();
+            return *this;
+        }
+    }
+
+    deallocate();
+
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        alloc_ = std::move(other.alloc_);
+
+    segments_ = std::move(other.segments_);
+    size_ = std::exchange(other.size_, 0);
+    return *this;
+}
+
+template <typename T, std::size_t SegmentSize, typename Allocator>
+void SegmentedVector<T, SegmentSize, Allocator>::reserve(const size_type new_capacity)
+{
+    segments_.reserve((new_capacity + SegmentSize - 1) / SegmentSize);
+
+    while (capacity() < new_capacity)
+        add_segment();
+}
+
+template <typename T, std::size_t SegmentSize, typename Allocator>
+void SegmentedVector<T, SegmentSize, Allocator>::shrink_to_fit()
+{
+    const size_type used = (size_ + SegmentSize - 1) / SegmentSize;
+
+    while (segments_.size() > used) {
+        alloc_traits::deallocate(alloc_, segments_.back(), SegmentSize);
+        segments_.pop_back();
+    }
+
+    segments_.shrink_to_fit();
+}
+
+template <typename T, std::size_t SegmentSize, typename Allocator>
+void SegmentedVector<T, SegmentSize, Allocator>::clear()
+{
+    for (size_type first = 0; first < size_; first += SegmentSize) {
+        const pointer segment = segments_[first >> shift];
+        destroy_values(alloc_, segment, segment + std::min(SegmentSize, size_ - first));
+    }
+
+    size_ = 0;
+}
+
+template <typename T, std::size_t SegmentSize, typename Allocator>
+template <typename... Args>
+typename SegmentedVector<T, SegmentSize, Allocator>::reference SegmentedVector<T, SegmentSize, Allocator>::emplace_back(Args&&... args)
+{
+    // a new segment leaves the other values in place, so args can refer to one of them
+    if (size_ == capacity())
+        add_segment();
+
+    const pointer p = segments_[size_ >> shift] + (size_ & mask);
+    alloc_traits::construct(alloc_, p, std::forward<Args>(args)...);
+    ++size_;
+    return *p;
+}
+
+template <typename T, std::size_t SegmentSize, typename Allocator>
+void SegmentedVector<T, SegmentSize, Allocator>::pop_back()
+{
+    assert(!empty());
+    --size_;
+    alloc_traits::destroy(alloc_, segments_[size_ >> shift] + (size_ & mask));
+}
+
+template <typename T, std::size_t SegmentSize, typename Allocator>
+void SegmentedVector<T, SegmentSize, Allocator>::resize(const size_type count)
+{
+    while (size_ > count)
+        pop_back();
+
+    reserve(count);
+
+    while (size_ < count)
+        emplace_back();
+}
+
+template <typename T, std::size_t SegmentSize, typename Allocator>
+void SegmentedVector<T, SegmentSize, Allocator>::resize(const size_type count, const T& value)
+{
+    while (size_ > count)
+        pop_back();
+
+    reserve(count);
+
+    while (size_ < count)
+        emplace_back(value);
+}
+
+template <typename T, std::size_t SegmentSize, typename Allocator>
+void SegmentedVector<T, SegmentSize, Allocator>::add_segment()
+{
+    const pointer segment = alloc_traits::allocate(alloc_, SegmentSize);
+
+    try {
+        segments_.push_back(segment);
+    } catch (...) {
+        alloc_traits::deallocate(alloc_, segment, SegmentSize);
+        throw;
+    }
+}
+
+template <typename T, std::size_t SegmentSize, typename Allocator>
+void SegmentedVector<T, SegmentSize, Allocator>::deallocate()
+{
+    for (const pointer segment : segments_)
+        alloc_traits::deallocate(alloc_, segment, SegmentSize);
+
+    segments_.clear();
+    segments_.shrink_to_fit();
+}
@@ -0,0 +1,439 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include "contiguous_iterator.hpp"
+#include "relocate.hpp"
+
+// A vector that stores up to N values inline and only allocates when it grows beyond that, then doubling its
+// capacity. Moving a vector whose values spilled to the heap takes over the heap buffer, moving an inline vector
+// moves the values one by one.
+template <typename T, std::size_t N, typename Allocator = std::allocator<T>>
+class SmallVector {
+private:
+    static_assert(N > 0, "use CustomVector for vectors without inline storage");
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+public:
+    using value_type = T;
+    using pointer = T*;
+    using reference = T&;
+    using const_pointer = const T*;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type = Allocator;
+    using iterator = ContiguousIterator<pointer, reference>;
+    using const_iterator = ContiguousIterator<const_pointer, const_reference>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr size_type inline_capacity = N;
+
+    SmallVector() : SmallVector(Allocator{}) { }
+    explicit SmallVector(const Allocator& alloc) : alloc_{alloc} { }
+    explicit SmallVector(size_type count, const Allocator& alloc = Allocator{});
+    SmallVector(size_type count, const T& value, const Allocator& alloc = Allocator{});
+    explicit SmallVector(std::initializer_list<T> init, const Allocator& alloc = Allocator{});
+
+    template <std::forward_iterator It>
+    SmallVector(It first, It last, const Allocator& alloc = Allocator{});
+
+    SmallVector(const SmallVector& other);
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+    ~SmallVector();
+
+    SmallVector& operator=(const SmallVector& other);
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T> && (alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value));
+
+    allocator_type get_allocator() const { return alloc_; }
+
+    size_type size() const { return static_cast<size_type>(end_ - begin_); }
+    size_type capacity() const { return static_cast<size_type>(capacity_end_ - begin_); }
+    [[nodiscard]] bool empty() const { return begin_ == end_; }
+
+    // true while the values are stored inline, without a heap allocation
+    [[nodiscard]] bool is_inline() const { return begin_ == inline_data(); }
+
+    pointer data() { return begin_; }
+    const_pointer data() const { return begin_; }
+
+    iterator begin() { return iterator{begin_}; }
+    const_iterator begin() const { return const_iterator{begin_}; }
+    const_iterator cbegin() const { return begin(); }
+
+    iterator end() { return iterator{end_}; }
+    const_iterator end() const { return const_iterator{end_}; }
+    const_iterator cend() const { return end(); }
+
+    reverse_iterator rbegin() { return reverse_iterator{end()}; }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator{end()}; }
+    const_reverse_iterator crbegin() const { return rbegin(); }
+
+    reverse_iterator rend() { return reverse_iterator{begin()}; }
+    const_reverse_iterator rend() const { return const_reverse_iterator{begin()}; }
+    const_reverse_iterator crend() const { return rend(); }
+
+    reference operator[](const size_type pos)
+    {
+        assert(pos < size());
+        return begin_[pos];
+    }
+
+    const_reference operator[](const size_type pos) const
+    {
+        assert(pos < size());
+        return begin_[pos];
+    }
+
+    reference front() { return (*this)[0]; }
+    const_reference front() const { return (*this)[0]; }
+
+    reference back() { return (*this)[size() - 1]; }
+    const_reference back() const { return (*this)[size() - 1]; }
+
+    void reserve(size_type new_capacity);
+    void clear();
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    reference emplace_back(Args&&... args);
+
+    void pop_back();
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+
+    iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+    iterator erase(const_iterator first, const_iterator last);
+
+    void resize(size_type count);
+    void resize(size_type count, const T& value);
+
+    friend bool operator==(const SmallVector& a, const SmallVector& b) { return std::equal(a.begin(), a.end(), b.begin(), b.end()); }
+
+private:
+    [[no_unique_address]] Allocator alloc_;
+    pointer begin_ = inline_data();
+    pointer end_ = begin_;
+    pointer capacity_end_ = begin_ + N;
+    alignas(T) std::byte storage_[N * sizeof(T)];
+
+    pointer inline_data() { return reinterpret_cast<pointer>(storage_); }
+    const_pointer inline_data() const { return reinterpret_cast<const_pointer>(storage_); }
+
+    // moves all values into a new heap buffer of the given capacity
+    void reallocate(size_type new_capacity);
+
+    // constructs the value at the end of a new, larger buffer and then moves the other values in front of it
+    template <typename... Args>
+    reference reallocate_and_emplace_back(Args&&... args);
+
+    // takes over the heap buffer of other, or moves its inline values, leaving other empty
+    void steal(SmallVector& other);
+
+    template <typename... Args>
+    void construct_at_end(size_type count, const Args&... args);
+
+    void deallocate();
+};
+
+template <typename T, std::size_t N>
+using PmrSmallVector = SmallVector<T, N, std::pmr::polymorphic_allocator<T>>;
+
+template <typename T, std::size_t N, typename Allocator>
+SmallVector<T, N, Allocator>::SmallVector(const size_type count, const Allocator& alloc) : SmallVector(alloc)
+{
+    reserve(count);
+    construct_at_end(count);
+}
+
+template <typename T, std::size_t N, typename Allocator>
+SmallVector<T, N, Allocator>::SmallVector(const size_type count, const T& value, const Allocator& alloc) : SmallVector(alloc)
+{
+    reserve(count);
+    construct_at_end(count, value);
+}
+
+template <typename T, std::size_t N, typename Allocator>
+SmallVector<T, N, Allocator>::SmallVector(const std::initializer_list<T> init, const Allocator& alloc) : SmallVector(init.begin(), init.end(), alloc)
+{
+}
+
+template <typename T, std::size_t N, typename Allocator>
+template <std::forward_iterator It>
+SmallVector<T, N, Allocator>::SmallVector(It first, const It last, const Allocator& alloc) : SmallVector(alloc)
+{
+    reserve(static_cast<size_type>(std::distance(first, last)));
+
+    for (; first != last; ++first) {
+        alloc_traits::construct(alloc_, end_, *first);
+        ++end_;
+    }
+}
+
+template <typename T, std::size_t N, typename Allocator>
+SmallVector<T, N, Allocator>::SmallVector(const SmallVector& other) : SmallVector(other.begin(), other.end(), alloc_traits::select_on_container_copy_construction(other.alloc_))
+{
+}
+
+template <typename T, std::size_t N, typename Allocator>
+SmallVector<T, N, Allocator>::SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : alloc_{std::move(other.alloc_)}
+{
+    steal(other);
+}
+
+template <typename T, std::size_t N, typename Allocator>
+SmallVector<T, N, Allocator>::~SmallVector()
+{
+    clear();
+    deallocate();
+}
+
+template <typename T, std::size_t N, typename Allocator>
+SmallVector<T, N, Allocator>& SmallVector<T, N, Allocator>::operator=(const SmallVector& other)
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+        if (alloc_ != other.alloc_)
+            deallocate();
+
+        alloc_ = other.alloc_;
+    }
+
+    reserve(other.size());
+
+    for (const T& value : other) {
+        alloc_traits::construct(alloc_, end_, value);
+        ++end_;
+    }
+
+    return *this;
+}
+
+template <typename T, std::size_t N, typename Allocator>
+SmallVector<T, N, Allocator>& SmallVector<T, N, Allocator>::operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T> && (alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value))
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+
+    // memory from another allocator (like another memory resource) cannot be taken over, only the values
+    if constexpr (!alloc_traits::propagate_on_container_move_assignment::value) {
+        if (alloc_ != other.alloc_) {
+            reserve(other.size());
+
+            for (T& value : other) {
+                alloc_traits::construct(alloc_, end_, std::move(value));
+                ++end_;
+            }
+
+            other.clear();
+            return *this;
+        }
+    }
+
+    deallocate();
+
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        alloc_ = std::move(other.alloc_);
+
+    steal(other);
+    return *this;
+}
+
+template <typename T, std::size_t N, typename Allocator>
+void SmallVector<T, N, Allocator>::reserve(const size_type new_capacity)
+{
+    if (new_capacity > capacity())
+        reallocate(new_capacity);
+}
+
+template <typename T, std::size_t N, typename Allocator>
+void SmallVector<T, N, Allocator>::clear()
+{
+    destroy_values(alloc_, begin_, end_);
+    end_ = begin_;
+}
+
+template <typename T, std::size_t N, typename Allocator>
+template <typename... Args>
+typename SmallVector<T, N, Allocator>::reference SmallVector<T, N, Allocator>::emplace_back(Args&&... args)
+{
+    if (end_ == capacity_end_)
+        return reallocate_and_emplace_back(std::forward<Args>(args)...);
+
+    alloc_traits::construct(alloc_, end_, std::forward<Args>(args)...);
+    return *end_++;
+}
+
+template <typename T, std::size_t N, typename Allocator>
+void SmallVector<T, N, Allocator>::pop_back()
+{
+    assert(!empty());
+    alloc_traits::destroy(alloc_, --end_);
+}
+
+template <typename T, std::size_t N, typename Allocator>
+template <typename... Args>
+typename SmallVector<T, N, Allocator>::iterator SmallVector<T, N, Allocator>::emplace(const const_iterator pos, Args&&... args)
+{
+    const auto offset = pos.base() - begin_;
+    assert(offset >= 0 && offset <= end_ - begin_);
+
+    // args could refer to a value of the vector that is about to move
+    emplace_back(std::forward<Args>(args)...);
+    std::rotate(begin_ + offset, end_ - 1, end_);
+    return iterator{begin_ + offset};
+}
+
+template <typename T, std::size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::iterator SmallVector<T, N, Allocator>::erase(const const_iterator first, const const_iterator last)
+{
+    const auto p = const_cast<pointer>(first.base());
+    const auto q = const_cast<pointer>(last.base());
+    assert(begin_ <= p && p <= q && q <= end_);
+
+    if (p != q) {
+        const pointer new_end = std::move(q, end_, p);
+        destroy_values(alloc_, new_end, end_);
+        end_ = new_end;
+    }
+
+    return iterator{p};
+}
+
+template <typename T, std::size_t N, typename Allocator>
+void SmallVector<T, N, Allocator>::resize(const size_type count)
+{
+    if (count < size()) {
+        destroy_values(alloc_, begin_ + count, end_);
+        end_ = begin_ + count;
+    } else {
+        reserve(count);
+        construct_at_end(count - size());
+    }
+}
+
+template <typename T, std::size_t N, typename Allocator>
+void SmallVector<T, N, Allocator>::resize(const size_type count, const T& value)
+{
+    if (count < size()) {
+        destroy_values(alloc_, begin_ + count, end_);
+        end_ = begin_ + count;
+    } else {
+        const T copy(value);
+        reserve(count);
+        construct_at_end(count - size(), copy);
+    }
+}
+
+template <typename T, std::size_t N, typename Allocator>
+void SmallVector<T, N, Allocator>::reallocate(const size_type new_capacity)
+{
+    assert(new_capacity > N && new_capacity >= size());
+
+    const size_type count = size();
+    const pointer new_begin = alloc_traits::allocate(alloc_, new_capacity);
+
+    try {
+        relocate_values(alloc_, begin_, end_, new_begin);
+    } catch (...) {
+        alloc_traits::deallocate(alloc_, new_begin, new_capacity);
+        throw;
+    }
+
+    deallocate();
+    begin_ = new_begin;
+    end_ = new_begin + count;
+    capacity_end_ = new_begin + new_capacity;
+}
+
+template <typename T, std::size_t N, typename Allocator>
+template <typename... Args>
+typename SmallVector<T, N, Allocator>::reference SmallVector<T, N, Allocator>::reallocate_and_emplace_back(Args&&... args)
+{
+    const size_type count = size();
+    const size_type new_capacity = 2 * capacity();
+    const pointer new_begin = alloc_traits::allocate(alloc_, new_capacity);
+
+    // construct first, args could refer to a value of the vector
+    try {
+        alloc_traits::construct(alloc_, new_begin + count, std::forward<Args>(args)...);
+    } catch (...) {
+        alloc_traits::deallocate(alloc_, new_begin, new_capacity);
+        throw;
+    }
+
+    try {
+        relocate_values(alloc_, begin_, end_, new_begin);
+    } catch (...) {
+        alloc_traits::destroy(alloc_, new_begin + count);
+        alloc_traits::deallocate(alloc_, new_begin, new_capacity);
+        throw;
+    }
+
+    deallocate();
+    begin_ = new_begin;
+    end_ = new_begin + count + 1;
+    capacity_end_ = new_begin + new_capacity;
+    return *(end_ - 1);
+}
+
+template <typename T, std::size_t N, typename Allocator>
+void SmallVector<T, N, Allocator>::steal(SmallVector& other)
+{
+    assert(is_inline() && empty());
+
+    if (other.is_inline()) {
+        relocate_values(alloc_, other.begin_, other.end_, begin_);
+        end_ = begin_ + other.size();
+        other.end_ = other.begin_;
+    } else {
+        begin_ = std::exchange(other.begin_, other.inline_data());
+        end_ = std::exchange(other.end_, other.inline_data());
+        capacity_end_ = std::exchange(other.capacity_end_, other.inline_data() + N);
+    }
+}
+
+template <typename T, std::size_t N, typename Allocator>
+template <typename... Args>
+void SmallVector<T, N, Allocator>::construct_at_end(const size_type count, const Args&... args)
+{
+    assert(count <= static_cast<size_type>(capacity_end_ - end_));
+
+    for (size_type i = 0; i < count; ++i) {
+        alloc_traits::construct(alloc_, end_, args...);
+        ++end_;
+    }
+}
+
+template <typename T, std::size_t N, typename Allocator>
+void SmallVector<T, N, Allocator>::deallocate()
+{
+    if (!is_inline())
+        alloc_traits::deallocate(alloc_, begin_, capacity());
+
+    begin_ = inline_data();
+    end_ = begin_;
+    capacity_end_ = begin_ + N;
+}
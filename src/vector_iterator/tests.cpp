@@ -1,13 +1,45 @@
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
 #include <numeric>
+#include <ratio>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "catch2/catch_approx.hpp"
+#include "catch2/catch_template_test_macros.hpp"
 #include "catch2/catch_test_macros.hpp"
 #include "catch2/matchers/catch_matchers_string.hpp"
 #include "fmt/core.h"
 #include "fmt/format.h"
 
+#define ALLOCATION_COUNTER_IMPLEMENT_OPERATOR_NEW
+#include "allocation_counter.hpp"
+#include "segmented_algorithms.hpp"
+
 #include "custom_vector.hpp"
+#include "segmented_vector.hpp"
+#include "small_vector.hpp"
+
+// the container type of a templated test with another value type
+template <typename Container, typename T>
+struct WithValueType;
+
+template <typename U, typename T>
+struct WithValueType<CustomVector<U>, T> {
+    using type = CustomVector<T>;
+};
+
+template <typename U, std::size_t SegmentSize, typename T>
+struct WithValueType<SegmentedVector<U, SegmentSize>, T> {
+    using type = SegmentedVector<T, SegmentSize>;
+};
 
 template <typename Iter>
 void check_bidirectional_iterator_requirements(Iter iter)
@@ -243,6 +275,20 @@ TEST_CASE("CustomVector")
         CHECK_THAT(vec[1], Catch::Matchers::Equals("xyzzy"));
     }
 
+    SECTION("can use CustomVector with a polymorphic allocator")
+    {
+        std::array<std::byte, 256> buffer{};
+        std::pmr::monotonic_buffer_resource resource{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+
+        const PmrCustomVector<int> vec{{1, 2, 3, 4}, &resource};
+
+        CHECK(vec.get_allocator().resource() == &resource);
+        CHECK(vec.size() == 4);
+        CHECK(vec[3] == 4);
+        CHECK(reinterpret_cast<const std::byte*>(&vec[0]) >= buffer.data());
+        CHECK(reinterpret_cast<const std::byte*>(&vec[0]) < buffer.data() + buffer.size());
+    }
+
     SECTION("operator[]")
     {
         SECTION("const")
@@ -342,9 +388,664 @@ TEST_CASE("CustomVector")
     }
 }
 
-TEST_CASE("CustomVector::iterator")
+// relocated with memcpy, which is safe for a std::unique_ptr
+template <>
+struct IsTriviallyRelocatable<std::unique_ptr<int>> : std::true_type { };
+
+// bytes allocated by TrackingAllocator and not deallocated yet
+inline std::size_t& tracked_bytes()
+{
+    static std::size_t bytes = 0;
+    return bytes;
+}
+
+template <typename T>
+struct TrackingAllocator {
+    using value_type = T;
+
+    TrackingAllocator() = default;
+
+    template <typename U>
+    TrackingAllocator(const TrackingAllocator<U>&) { }
+
+    [[nodiscard]] T* allocate(const std::size_t n)
+    {
+        tracked_bytes() += n * sizeof(T);
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, const std::size_t n)
+    {
+        tracked_bytes() -= n * sizeof(T);
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const TrackingAllocator<U>&) const { return true; }
+};
+
+// counts its live instances, the default and copy constructors throw once constructions_until_throw reaches 0
+struct ThrowingValue {
+    static inline int live = 0;
+    static inline int constructions_until_throw = -1;
+
+    int value = 0;
+
+    ThrowingValue() { construct(); }
+    ThrowingValue(const int v) : value{v} { ++live; }
+    ThrowingValue(const ThrowingValue& other) : value{other.value} { construct(); }
+    ~ThrowingValue() { --live; }
+
+    ThrowingValue& operator=(const ThrowingValue&) = default;
+
+private:
+    void construct()
+    {
+        if (constructions_until_throw-- == 0)
+            throw std::runtime_error{"construction failed"};
+
+        ++live;
+    }
+};
+
+// construct() throws from the third value constructor and neither leaks its buffer nor destroys values it did not construct
+template <typename Construct>
+void check_construction_throws_cleanly(Construct construct)
+{
+    const int live = ThrowingValue::live;
+    const std::size_t bytes = tracked_bytes();
+
+    ThrowingValue::constructions_until_throw = 2;
+    CHECK_THROWS_AS(static_cast<void>(construct()), std::runtime_error);
+    ThrowingValue::constructions_until_throw = -1;
+
+    CHECK(ThrowingValue::live == live);
+    CHECK(tracked_bytes() == bytes);
+}
+
+TEST_CASE("CustomVector modifiers")
+{
+    SECTION("push_back() and emplace_back() grow the capacity")
+    {
+        CustomVector<int> vec;
+
+        for (int i = 0; i < 100; ++i)
+            vec.push_back(i);
+
+        CHECK(vec.size() == 100);
+        CHECK(vec.capacity() >= 100);
+        CHECK(vec.front() == 0);
+        CHECK(vec.back() == 99);
+        CHECK(vec.emplace_back(100) == 100);
+        CHECK(vec.size() == 101);
+    }
+
+    SECTION("the growth factor sets the capacities")
+    {
+        CustomVector<int, std::allocator<int>, std::ratio<2, 1>> doubling;
+        CustomVector<int> growing;
+        std::vector<std::size_t> doubling_capacities;
+        std::vector<std::size_t> growing_capacities;
+
+        for (int i = 0; i < 20; ++i) {
+            doubling.push_back(i);
+            growing.push_back(i);
+
+            if (doubling_capacities.empty() || doubling_capacities.back() != doubling.capacity())
+                doubling_capacities.push_back(doubling.capacity());
+
+            if (growing_capacities.empty() || growing_capacities.back() != growing.capacity())
+                growing_capacities.push_back(growing.capacity());
+        }
+
+        CHECK(doubling_capacities == std::vector<std::size_t>{4, 8, 16, 32});
+        CHECK(growing_capacities == std::vector<std::size_t>{4, 6, 9, 13, 19, 28});
+    }
+
+    SECTION("resize() grows the capacity by the growth factor")
+    {
+        CustomVector<int> vec;
+        std::vector<std::size_t> capacities;
+
+        for (int i = 0; i < 20; ++i) {
+            vec.resize(vec.size() + 1);
+
+            if (capacities.empty() || capacities.back() != vec.capacity())
+                capacities.push_back(vec.capacity());
+        }
+
+        CHECK(capacities == std::vector<std::size_t>{4, 6, 9, 13, 19, 28});
+
+        vec.resize(100, 1);
+        CHECK(vec.capacity() == 100);
+    }
+
+    SECTION("constructors release everything when a value constructor throws")
+    {
+        using Vector = CustomVector<ThrowingValue, TrackingAllocator<ThrowingValue>>;
+        const Vector values{1, 2, 3, 4, 5};
+
+        check_construction_throws_cleanly([] { return Vector(5); });
+        check_construction_throws_cleanly([] { return Vector(5, ThrowingValue{1}); });
+        check_construction_throws_cleanly([&] { return Vector(values.begin(), values.end()); });
+        check_construction_throws_cleanly([] { return Vector{1, 2, 3, 4, 5}; });
+        check_construction_throws_cleanly([&] { return Vector(values); });
+        check_construction_throws_cleanly([] { return Vector(5, for_overwrite); });
+        CHECK(ThrowingValue::live == 5);
+    }
+
+    SECTION("reserve() keeps values in place until the capacity is exceeded")
+    {
+        CustomVector<int> vec{1, 2};
+        vec.reserve(10);
+        const int* data = vec.data();
+
+        for (int i = 3; i <= 10; ++i)
+            vec.push_back(i);
+
+        CHECK(vec.data() == data);
+        CHECK(vec.capacity() == 10);
+        CHECK(vec == CustomVector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+
+        vec.reserve(5);
+        CHECK(vec.capacity() == 10);
+    }
+
+    SECTION("values survive reallocation")
+    {
+        CustomVector<std::string> strings;
+        CustomVector<std::unique_ptr<int>> pointers;
+
+        for (int i = 0; i < 50; ++i) {
+            strings.push_back(fmt::format("a long string that is not stored inline {}", i));
+            pointers.push_back(std::make_unique<int>(i));
+        }
+
+        for (std::size_t i = 0; i < 50; ++i) {
+            CHECK(strings[i] == fmt::format("a long string that is not stored inline {}", i));
+            CHECK(*pointers[i] == static_cast<int>(i));
+        }
+    }
+
+    SECTION("insert() and emplace()")
+    {
+        CustomVector<std::string> vec{"b", "d"};
+        vec.reserve(8);
+
+        CHECK(*vec.insert(vec.begin(), "a") == "a");
+        CHECK(*vec.emplace(vec.begin() + 2, "c") == "c");
+        CHECK(*vec.insert(vec.end(), "e") == "e");
+        CHECK(vec == CustomVector<std::string>{"a", "b", "c", "d", "e"});
+
+        // inserting a value of the vector itself, with and without reallocation
+        vec.insert(vec.begin(), vec.back());
+        CHECK(vec == CustomVector<std::string>{"e", "a", "b", "c", "d", "e"});
+
+        vec.shrink_to_fit();
+        vec.insert(vec.begin() + 1, vec.back());
+        CHECK(vec == CustomVector<std::string>{"e", "e", "a", "b", "c", "d", "e"});
+    }
+
+    SECTION("insert() count copies")
+    {
+        CustomVector<std::string> vec{"a", "b", "c", "d"};
+        vec.reserve(16);
+
+        // fewer values than the tail after the insert position
+        vec.insert(vec.begin() + 1, 2, "x");
+        CHECK(vec == CustomVector<std::string>{"a", "x", "x", "b", "c", "d"});
+
+        // more values than the tail
+        vec.insert(vec.end() - 1, 3, "y");
+        CHECK(vec == CustomVector<std::string>{"a", "x", "x", "b", "c", "y", "y", "y", "d"});
+
+        vec.insert(vec.begin(), 0, "z");
+        CHECK(vec.size() == 9);
+
+        // with reallocation
+        vec.insert(vec.begin(), 10, vec[3]);
+        CHECK(vec.size() == 19);
+        CHECK(std::count(vec.begin(), vec.begin() + 10, "b") == 10);
+        CHECK(vec[10] == "a");
+    }
+
+    SECTION("erase()")
+    {
+        CustomVector<std::string> vec{"a", "b", "c", "d", "e"};
+
+        CHECK(*vec.erase(vec.begin() + 1) == "c");
+        CHECK(vec == CustomVector<std::string>{"a", "c", "d", "e"});
+
+        CHECK(*vec.erase(vec.begin() + 1, vec.begin() + 3) == "e");
+        CHECK(vec == CustomVector<std::string>{"a", "e"});
+
+        CHECK(vec.erase(vec.begin(), vec.begin()) == vec.begin());
+        const auto it = vec.erase(vec.begin(), vec.end());
+        CHECK(it == vec.end());
+        CHECK(vec.empty());
+    }
+
+    SECTION("resize(), pop_back() and clear()")
+    {
+        CustomVector<int> vec{1, 2, 3};
+
+        vec.resize(5);
+        CHECK(vec == CustomVector<int>{1, 2, 3, 0, 0});
+
+        vec.resize(7, 9);
+        CHECK(vec == CustomVector<int>{1, 2, 3, 0, 0, 9, 9});
+
+        vec.resize(2);
+        CHECK(vec == CustomVector<int>{1, 2});
+
+        vec.pop_back();
+        CHECK(vec == CustomVector<int>{1});
+
+        vec.clear();
+        CHECK(vec.empty());
+        CHECK(vec.capacity() >= 7);
+
+        vec.shrink_to_fit();
+        CHECK(vec.capacity() == 0);
+        CHECK(vec.data() == nullptr);
+    }
+
+    SECTION("resize_default_init() and resize_uninitialized()")
+    {
+        CustomVector<int> ints{1, 2};
+        ints.resize_default_init(4);
+        CHECK(ints.size() == 4);
+        CHECK(ints[1] == 2);
+
+        ints.resize_uninitialized(6);
+        std::iota(ints.begin(), ints.end(), 10);
+        CHECK(ints == CustomVector<int>{10, 11, 12, 13, 14, 15});
+
+        ints.resize_uninitialized(3);
+        CHECK(ints == CustomVector<int>{10, 11, 12});
+
+        // values of other types are still constructed
+        CustomVector<std::string> strings{"a"};
+        strings.resize_default_init(3);
+        CHECK(strings == CustomVector<std::string>{"a", "", ""});
+    }
+
+    SECTION("resize_default_init() and resize_uninitialized() grow the capacity by the growth factor")
+    {
+        CustomVector<int> default_init;
+        CustomVector<int> uninitialized;
+        std::vector<std::size_t> default_init_capacities;
+        std::vector<std::size_t> uninitialized_capacities;
+
+        for (int i = 0; i < 20; ++i) {
+            default_init.resize_default_init(default_init.size() + 1);
+            uninitialized.resize_uninitialized(uninitialized.size() + 1);
+
+            if (default_init_capacities.empty() || default_init_capacities.back() != default_init.capacity())
+                default_init_capacities.push_back(default_init.capacity());
+
+            if (uninitialized_capacities.empty() || uninitialized_capacities.back() != uninitialized.capacity())
+                uninitialized_capacities.push_back(uninitialized.capacity());
+        }
+
+        CHECK(default_init_capacities == std::vector<std::size_t>{4, 6, 9, 13, 19, 28});
+        CHECK(uninitialized_capacities == std::vector<std::size_t>{4, 6, 9, 13, 19, 28});
+    }
+
+    SECTION("for_overwrite constructor")
+    {
+        CustomVector<double> doubles(8, for_overwrite);
+        CHECK(doubles.size() == 8);
+        CHECK(doubles.capacity() == 8);
+
+        const CustomVector<std::string> strings(2, for_overwrite);
+        CHECK(strings == CustomVector<std::string>{"", ""});
+    }
+
+    SECTION("append_uninitialized()")
+    {
+        CustomVector<char> buffer{'a'};
+
+        const std::span<char> first = buffer.append_uninitialized(3);
+        CHECK(first.size() == 3);
+        CHECK(first.data() == buffer.data() + 1);
+        std::fill(first.begin(), first.end(), 'b');
+
+        const std::span<char> second = buffer.append_uninitialized(2);
+        std::fill(second.begin(), second.end(), 'c');
+
+        CHECK(buffer == CustomVector<char>{'a', 'b', 'b', 'b', 'c', 'c'});
+        CHECK(buffer.append_uninitialized(0).empty());
+        CHECK(buffer.size() == 6);
+    }
+
+    SECTION("copy, move and swap")
+    {
+        CustomVector<std::string> vec{"a", "b", "c"};
+
+        CustomVector<std::string> copy{vec};
+        CHECK(copy == vec);
+
+        CustomVector<std::string> moved{std::move(copy)};
+        CHECK(moved == vec);
+        CHECK(copy.empty());  // NOLINT(bugprone-use-after-move)
+
+        copy = moved;
+        CHECK(copy == vec);
+
+        CustomVector<std::string> other{"x"};
+        other = std::move(moved);
+        CHECK(other == vec);
+
+        other.swap(copy);
+        CHECK(other == vec);
+        CHECK(copy == vec);
+
+        const CustomVector<std::string> filled(3, "z");
+        copy = filled;
+        CHECK(copy == CustomVector<std::string>{"z", "z", "z"});
+    }
+
+    SECTION("move assignment copies the values when the allocators differ")
+    {
+        std::array<std::byte, 256> buffer1{};
+        std::array<std::byte, 256> buffer2{};
+        std::pmr::monotonic_buffer_resource resource1{buffer1.data(), buffer1.size(), std::pmr::null_memory_resource()};
+        std::pmr::monotonic_buffer_resource resource2{buffer2.data(), buffer2.size(), std::pmr::null_memory_resource()};
+
+        PmrCustomVector<int> vec1{{1, 2, 3, 4}, &resource1};
+        PmrCustomVector<int> vec2{&resource2};
+        vec2 = std::move(vec1);
+
+        CHECK(vec2.get_allocator().resource() == &resource2);
+        CHECK(vec2 == PmrCustomVector<int>{1, 2, 3, 4});
+        CHECK(reinterpret_cast<const std::byte*>(vec2.data()) >= buffer2.data());
+        CHECK(reinterpret_cast<const std::byte*>(vec2.data()) < buffer2.data() + buffer2.size());
+    }
+}
+
+TEST_CASE("SmallVector")
 {
-    const CustomVector<int> vec{1, 2, 3, 4, 5, 6, 7, 8};
+    SECTION("stores up to N values inline")
+    {
+        SmallVector<int, 4> vec{1, 2, 3};
+        CHECK(vec.is_inline());
+        CHECK(vec.capacity() == 4);
+
+        vec.push_back(4);
+        CHECK(vec.is_inline());
+
+        vec.push_back(5);
+        CHECK_FALSE(vec.is_inline());
+        CHECK(vec.capacity() == 8);
+        CHECK(vec == SmallVector<int, 4>{1, 2, 3, 4, 5});
+    }
+
+    SECTION("modifiers")
+    {
+        SmallVector<std::string, 2> vec{"b", "d"};
+
+        CHECK(*vec.insert(vec.begin(), "a") == "a");
+        CHECK(*vec.emplace(vec.begin() + 2, "c") == "c");
+        CHECK(*vec.insert(vec.end(), vec.front()) == "a");
+        CHECK(vec == SmallVector<std::string, 2>{"a", "b", "c", "d", "a"});
+
+        CHECK(*vec.erase(vec.begin() + 1, vec.begin() + 3) == "d");
+        vec.pop_back();
+        CHECK(vec == SmallVector<std::string, 2>{"a", "d"});
+
+        vec.resize(4, "x");
+        CHECK(vec == SmallVector<std::string, 2>{"a", "d", "x", "x"});
+
+        vec.resize(1);
+        CHECK(vec.back() == "a");
+
+        vec.clear();
+        CHECK(vec.empty());
+    }
+
+    SECTION("iterators")
+    {
+        SmallVector<int, 8> vec{3, 1, 2};
+        std::sort(vec.begin(), vec.end());
+
+        CHECK(std::accumulate(vec.cbegin(), vec.cend(), 0) == 6);
+        CHECK(*vec.rbegin() == 3);
+        CHECK(vec.end() - vec.begin() == 3);
+        check_random_access_iterator_requirements(vec.begin(), vec.begin() + 1);
+    }
+
+    SECTION("copy")
+    {
+        const SmallVector<std::string, 2> small{"a"};
+        const SmallVector<std::string, 2> large{"a", "b", "c"};
+
+        SmallVector<std::string, 2> copy{large};
+        CHECK(copy == large);
+        CHECK(copy.data() != large.data());
+
+        copy = small;
+        CHECK(copy == small);
+    }
+
+    SECTION("constructors release everything when a value constructor throws")
+    {
+        using Spilled = SmallVector<ThrowingValue, 2, TrackingAllocator<ThrowingValue>>;
+        using Inline = SmallVector<ThrowingValue, 8, TrackingAllocator<ThrowingValue>>;
+        const Spilled values{1, 2, 3, 4, 5};
+
+        check_construction_throws_cleanly([] { return Spilled(5); });
+        check_construction_throws_cleanly([] { return Spilled(5, ThrowingValue{1}); });
+        check_construction_throws_cleanly([&] { return Spilled(values.begin(), values.end()); });
+        check_construction_throws_cleanly([] { return Spilled{1, 2, 3, 4, 5}; });
+        check_construction_throws_cleanly([&] { return Spilled(values); });
+        check_construction_throws_cleanly([] { return Inline(5); });
+        check_construction_throws_cleanly([] { return Inline{1, 2, 3, 4, 5}; });
+        CHECK(ThrowingValue::live == 5);
+    }
+
+    SECTION("moving a spilled vector takes over its heap buffer")
+    {
+        SmallVector<std::string, 2> vec{"a", "b", "c"};
+        const std::string* data = vec.data();
+
+        SmallVector<std::string, 2> moved{std::move(vec)};
+        CHECK(moved.data() == data);
+        CHECK(moved == SmallVector<std::string, 2>{"a", "b", "c"});
+        CHECK(vec.empty());  // NOLINT(bugprone-use-after-move)
+        CHECK(vec.is_inline());
+
+        SmallVector<std::string, 2> assigned{"x"};
+        assigned = std::move(moved);
+        CHECK(assigned.data() == data);
+        CHECK(moved.is_inline());  // NOLINT(bugprone-use-after-move)
+    }
+
+    SECTION("moving an inline vector moves its values")
+    {
+        SmallVector<std::unique_ptr<int>, 4> vec;
+        vec.push_back(std::make_unique<int>(1));
+        vec.push_back(std::make_unique<int>(2));
+
+        SmallVector<std::unique_ptr<int>, 4> moved{std::move(vec)};
+        CHECK(moved.is_inline());
+        CHECK(*moved[1] == 2);
+        CHECK(vec.empty());  // NOLINT(bugprone-use-after-move)
+
+        SmallVector<std::unique_ptr<int>, 4> assigned;
+        assigned.push_back(std::make_unique<int>(3));
+        assigned = std::move(moved);
+        CHECK(assigned.size() == 2);
+        CHECK(*assigned[0] == 1);
+    }
+
+    SECTION("move assignment is noexcept when moving the values and the allocator cannot throw")
+    {
+        static_assert(std::is_nothrow_move_assignable_v<SmallVector<std::unique_ptr<int>, 4>>);
+        static_assert(!std::is_nothrow_move_assignable_v<SmallVector<ThrowingValue, 4>>);
+        static_assert(!std::is_nothrow_move_assignable_v<PmrSmallVector<int, 4>>);
+    }
+
+    SECTION("can use SmallVector with a polymorphic allocator")
+    {
+        std::array<std::byte, 256> buffer{};
+        std::pmr::monotonic_buffer_resource resource{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+
+        PmrSmallVector<int, 2> vec{{1, 2, 3, 4}, &resource};
+
+        CHECK(vec.get_allocator().resource() == &resource);
+        CHECK_FALSE(vec.is_inline());
+        CHECK(reinterpret_cast<const std::byte*>(vec.data()) >= buffer.data());
+        CHECK(reinterpret_cast<const std::byte*>(vec.data()) < buffer.data() + buffer.size());
+    }
+}
+
+TEST_CASE("SegmentedVector")
+{
+    SECTION("growing keeps the values in place")
+    {
+        SegmentedVector<int, 4> vec;
+        std::vector<const int*> addresses;
+
+        for (int i = 0; i < 100; ++i)
+            addresses.push_back(&vec.emplace_back(i));
+
+        CHECK(vec.size() == 100);
+        CHECK(vec.capacity() == 100);
+
+        for (std::size_t i = 0; i < 100; ++i) {
+            CHECK(&vec[i] == addresses[i]);
+            CHECK(vec[i] == static_cast<int>(i));
+        }
+    }
+
+    SECTION("segments are contiguous")
+    {
+        const SegmentedVector<int, 4> vec{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+        CHECK(vec.begin().segment_remaining() == 4);
+        CHECK((vec.begin() + 5).segment_remaining() == 3);
+        CHECK((vec.begin() + 5).base() == &vec[5]);
+        CHECK((vec.begin() + 5).base() + 2 == &vec[7]);
+        CHECK((vec.begin() + 8).base() != &vec[7] + 1);
+    }
+
+    SECTION("modifiers")
+    {
+        SegmentedVector<std::string, 2> vec{"a", "b", "c"};
+
+        vec.push_back("d");
+        vec.push_back(vec.front());
+        CHECK(vec == SegmentedVector<std::string, 2>{"a", "b", "c", "d", "a"});
+
+        vec.pop_back();
+        vec.resize(6, "x");
+        CHECK(vec == SegmentedVector<std::string, 2>{"a", "b", "c", "d", "x", "x"});
+
+        vec.resize(1);
+        CHECK(vec.back() == "a");
+        CHECK(vec.capacity() == 6);
+
+        vec.shrink_to_fit();
+        CHECK(vec.capacity() == 2);
+
+        vec.clear();
+        CHECK(vec.empty());
+        CHECK(vec.capacity() == 2);
+    }
+
+    SECTION("copy and move")
+    {
+        SegmentedVector<std::string, 2> vec{"a", "b", "c"};
+        const std::string* first = &vec[0];
+
+        SegmentedVector<std::string, 2> copy{vec};
+        CHECK(copy == vec);
+        CHECK(&copy[0] != first);
+
+        SegmentedVector<std::string, 2> moved{std::move(vec)};
+        CHECK(&moved[0] == first);
+        CHECK(vec.empty());  // NOLINT(bugprone-use-after-move)
+
+        copy = SegmentedVector<std::string, 2>{"x"};
+        CHECK(copy == SegmentedVector<std::string, 2>{"x"});
+
+        copy = moved;
+        CHECK(copy == moved);
+    }
+
+    SECTION("can use SegmentedVector with a polymorphic allocator")
+    {
+        std::array<std::byte, 512> buffer{};
+        std::pmr::monotonic_buffer_resource resource{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+
+        const PmrSegmentedVector<int, 4> vec{{1, 2, 3, 4, 5}, &resource};
+
+        CHECK(vec.get_allocator().resource() == &resource);
+        CHECK(reinterpret_cast<const std::byte*>(&vec[4]) >= buffer.data());
+        CHECK(reinterpret_cast<const std::byte*>(&vec[4]) < buffer.data() + buffer.size());
+    }
+}
+
+TEST_CASE("segmented algorithms")
+{
+    SegmentedVector<int, 4> segmented;
+
+    for (int i = 1; i <= 10; ++i)
+        segmented.push_back(i);
+
+    SECTION("dispatch")
+    {
+        static_assert(SegmentedMemoryIterator<SegmentedVector<int, 4>::iterator>);
+        static_assert(std::contiguous_iterator<CustomVector<int>::iterator>);
+        static_assert(std::contiguous_iterator<SmallVector<int, 4>::const_iterator>);
+        static_assert(!ChunkedMemoryIterator<CustomVector<int>::reverse_iterator>);
+
+        const auto chunk = memory_chunk(segmented.cbegin() + 5, 10);
+        CHECK(chunk.ptr == &segmented[5]);
+        CHECK(chunk.stride == 1);
+        CHECK(chunk.count == 3);
+    }
+
+    SECTION("segmented_accumulate() and segmented_for_each()")
+    {
+        CHECK(segmented_accumulate(segmented.begin(), segmented.end(), 0) == 55);
+        CHECK(segmented_accumulate(segmented.begin() + 3, segmented.end() - 2, 0) == 4 + 5 + 6 + 7 + 8);
+        CHECK(segmented_accumulate(segmented.rbegin(), segmented.rend(), 0) == 55);
+
+        CustomVector<int> visited;
+        segmented_for_each(segmented.begin() + 2, segmented.end(), [&](const int value) { visited.push_back(value); });
+        CHECK(visited == CustomVector<int>{3, 4, 5, 6, 7, 8, 9, 10});
+    }
+
+    SECTION("segmented_copy() and segmented_transform() between different segment sizes")
+    {
+        SegmentedVector<int, 8> other(12, 0);
+
+        CHECK(segmented_copy(segmented.begin(), segmented.end(), other.begin() + 1) == other.begin() + 11);
+        CHECK(other == SegmentedVector<int, 8>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0});
+
+        CustomVector<int> squares(10);
+        CHECK(segmented_transform(segmented.cbegin(), segmented.cend(), squares.begin(), [](const int value) { return value * value; }) == squares.end());
+        CHECK(squares == CustomVector<int>{1, 4, 9, 16, 25, 36, 49, 64, 81, 100});
+    }
+
+    SECTION("segmented_fill() and segmented_find()")
+    {
+        segmented_fill(segmented.begin() + 2, segmented.begin() + 9, 0);
+        CHECK(segmented == SegmentedVector<int, 4>{1, 2, 0, 0, 0, 0, 0, 0, 0, 10});
+
+        CHECK(segmented_find(segmented.begin(), segmented.end(), 10) == segmented.end() - 1);
+        CHECK(segmented_find(segmented.begin(), segmented.end(), 11) == segmented.end());
+
+        const SmallVector<int, 4> small{5, 6, 7};
+        CHECK(segmented_find(small.begin(), small.end(), 7) == small.begin() + 2);
+    }
+}
+
+TEMPLATE_TEST_CASE("iterator", "", CustomVector<int>, (SegmentedVector<int, 4>))
+{
+    const TestType vec{1, 2, 3, 4, 5, 6, 7, 8};
 
     SECTION("iterate values")
     {
@@ -413,7 +1114,7 @@ TEST_CASE("CustomVector::iterator")
                 int x;
             };
 
-            CustomVector<S> v{S{1}, S{2}};
+            typename WithValueType<TestType, S>::type v{S{1}, S{2}};
             auto it = v.begin();
 
             CHECK(it->x == 1);
@@ -478,7 +1179,7 @@ TEST_CASE("CustomVector::iterator")
 
             SECTION("non-const")
             {
-                CustomVector<int> numbers{1, 2, 3, 4, 5, 6, 7, 8};
+                TestType numbers{1, 2, 3, 4, 5, 6, 7, 8};
                 auto it = numbers.begin();
 
                 CHECK(it[0] == 1);
@@ -555,7 +1256,7 @@ TEST_CASE("CustomVector::iterator")
 
         SECTION("std::sort")
         {
-            CustomVector<int> numbers{1, 2, 3, 4, 5, 6, 7, 8};
+            TestType numbers{1, 2, 3, 4, 5, 6, 7, 8};
 
             std::sort(numbers.begin(), numbers.end(), std::greater{});  // sort in reverse order
 
@@ -572,9 +1273,9 @@ TEST_CASE("CustomVector::iterator")
     }
 }
 
-TEST_CASE("CustomVector::reverse_iterator")
+TEMPLATE_TEST_CASE("reverse_iterator", "", CustomVector<int>, (SegmentedVector<int, 4>))
 {
-    const CustomVector<int> vec{1, 2, 3, 4, 5, 6, 7, 8};
+    const TestType vec{1, 2, 3, 4, 5, 6, 7, 8};
 
     SECTION("iterate values")
     {
@@ -633,7 +1334,7 @@ TEST_CASE("CustomVector::reverse_iterator")
                 int x;
             };
 
-            const CustomVector<S> v{S{1}, S{2}};
+            const typename WithValueType<TestType, S>::type v{S{1}, S{2}};
             auto it = v.rbegin();
 
             CHECK(it->x == 2);
@@ -698,7 +1399,7 @@ TEST_CASE("CustomVector::reverse_iterator")
 
             SECTION("non-const")
             {
-                CustomVector<int> numbers{1, 2, 3, 4, 5, 6, 7, 8};
+                TestType numbers{1, 2, 3, 4, 5, 6, 7, 8};
                 auto it = numbers.rbegin();
 
                 CHECK(it[0] == 8);
@@ -775,7 +1476,7 @@ TEST_CASE("CustomVector::reverse_iterator")
 
         SECTION("std::sort")
         {
-            CustomVector<int> numbers{1, 2, 3, 4, 5, 6, 7, 8};
+            TestType numbers{1, 2, 3, 4, 5, 6, 7, 8};
 
             std::sort(numbers.rbegin(), numbers.rend());  // sort in reverse order
 
@@ -791,3 +1492,105 @@ TEST_CASE("CustomVector::reverse_iterator")
         }
     }
 }
+
+TEST_CASE("CustomVector allocations")
+{
+    REQUIRE(AllocationCounter::operator_new_hooked());
+
+    SECTION("constructing from an initializer list allocates once")
+    {
+        CHECK(count_allocations([] { const CustomVector<int> vec{1, 2, 3, 4}; }) == AllocationStats{1, 4 * sizeof(int)});
+    }
+
+    SECTION("iterating does not allocate")
+    {
+        CustomVector<int> vec{1, 2, 3, 4, 5, 6, 7, 8};
+        int sum = 0;
+
+        const auto allocations = count_allocations([&] {
+            sum += std::accumulate(vec.begin(), vec.end(), 0);
+            sum += std::accumulate(vec.crbegin(), vec.crend(), 0);
+            std::sort(vec.rbegin(), vec.rend());
+
+            for (std::size_t i = 0; i < vec.size(); ++i)
+                sum += vec[i];
+        });
+
+        CHECK(allocations == AllocationStats{});
+        CHECK(sum == 3 * 36);
+    }
+
+    SECTION("push_back() after reserve() does not allocate")
+    {
+        CustomVector<int> vec;
+        vec.reserve(100);
+
+        CHECK(count_allocations([&] {
+            for (int i = 0; i < 100; ++i)
+                vec.push_back(i);
+        }) == AllocationStats{});
+    }
+
+    SECTION("push_back() allocates once per growth step")
+    {
+        // capacities 4, 8, 16, 32, 64, 128
+        CHECK(count_allocations([] {
+            CustomVector<int, std::allocator<int>, std::ratio<2, 1>> vec;
+
+            for (int i = 0; i < 100; ++i)
+                vec.push_back(i);
+        }).count == 6);
+    }
+
+    SECTION("append_uninitialized() grows like push_back()")
+    {
+        // capacities 4, 8, 16, 32, 64, 128
+        CHECK(count_allocations([] {
+            CustomVector<int, std::allocator<int>, std::ratio<2, 1>> vec;
+
+            for (int i = 0; i < 100; ++i)
+                vec.append_uninitialized(1)[0] = i;
+        }).count == 6);
+    }
+
+    SECTION("SmallVector allocates only beyond its inline capacity")
+    {
+        CHECK(count_allocations([] {
+            SmallVector<int, 16> vec;
+
+            for (int i = 0; i < 16; ++i)
+                vec.push_back(i);
+        }) == AllocationStats{});
+
+        CHECK(count_allocations([] {
+            SmallVector<int, 16> vec;
+
+            for (int i = 0; i < 17; ++i)
+                vec.push_back(i);
+        }) == AllocationStats{1, 32 * sizeof(int)});
+    }
+
+    SECTION("moving a spilled SmallVector does not allocate")
+    {
+        SmallVector<int, 2> vec{1, 2, 3};
+
+        CHECK(count_allocations([&] {
+            const SmallVector<int, 2> moved{std::move(vec)};
+        }) == AllocationStats{});
+    }
+
+    SECTION("CountingAllocator counts the allocations of a single CustomVector")
+    {
+        AllocationStats allocations;
+
+        {
+            const AllocationCounter counter;
+            const CustomVector<int, CountingAllocator<int>> vec{1, 2, 3, 4};
+            const std::vector<int> other{1, 2, 3, 4};
+            allocations = counter.allocations();
+        }
+
+        // CountingAllocator and operator new each count the allocation of vec, operator new the one of other
+        CHECK(allocations == AllocationStats{3, 3 * 4 * sizeof(int)});
+    }
+}